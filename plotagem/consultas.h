@@ -0,0 +1,110 @@
+#ifndef CONSULTAS_H
+#define CONSULTAS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+/*
+    CONSULTAS
+
+    Geracao das chaves de busca de cada padrao de acesso e utilitarios comuns
+    a latencia.c e vazao.c:
+
+      - uniforme:   chaves presentes sorteadas do proprio conjunto de dados
+      - zipf:       chaves presentes com popularidade Zipf (expoente 1): poucas
+                    chaves concentram a maior parte das buscas
+      - sequencial: chaves presentes em ordem crescente
+      - ausentes:   chaves do mesmo intervalo que nao estao no conjunto
+*/
+
+typedef enum { UNIFORME, ZIPF, SEQUENCIAL, AUSENTES, N_PADROES } Padrao;
+const char* NOMES_PADROES[N_PADROES] = {"uniforme", "zipf", "sequencial", "ausentes"};
+
+
+//xorshift64*: rand() so vai ate 32767 em algumas plataformas
+unsigned int aleatorio(unsigned long long* estado) {
+    *estado ^= *estado >> 12;
+    *estado ^= *estado << 25;
+    *estado ^= *estado >> 27;
+    return (unsigned int)((*estado * 2685821657736338717ULL) >> 32);
+}
+
+double agora(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+//1 se nome aparece na lista separada por virgulas (lista NULL aceita tudo)
+int na_lista(const char* lista, const char* nome) {
+    if (lista == NULL) return 1;
+    size_t tamanho = strlen(nome);
+    for (const char* p = lista; *p; ) {
+        const char* fim = strchr(p, ',');
+        size_t len = fim ? (size_t)(fim - p) : strlen(p);
+        if (len == tamanho && strncmp(p, nome, len) == 0) return 1;
+        if (!fim) break;
+        p = fim + 1;
+    }
+    return 0;
+}
+
+int contem(const int* ordenado, long n, int chave) {
+    long inicio = 0, fim = n;
+    while (inicio < fim) {
+        long meio = (inicio + fim) / 2;
+        if (ordenado[meio] < chave) inicio = meio + 1;
+        else fim = meio;
+    }
+    return inicio < n && ordenado[inicio] == chave;
+}
+
+//Chaves de busca de um padrao; ordenado e a copia ordenada de dados
+int* gerar_consultas(Padrao padrao, const int* dados, const int* ordenado, long n, int num,
+                     unsigned long long* estado) {
+    int* consultas = (int*)malloc(num * sizeof(int));
+    double log_n = log((double)n + 1);
+    for (int i = 0; i < num; i++) {
+        switch (padrao) {
+            case UNIFORME:
+                consultas[i] = dados[aleatorio(estado) % n];
+                break;
+            case ZIPF: {
+                //Inversao da aproximacao continua: P(posicao <= r) ~ ln(r) / ln(n)
+                double u = aleatorio(estado) / 4294967296.0;
+                long r = (long)exp(u * log_n) - 1;
+                //Espalha as posicoes populares: dados[0], dados[1], ... sao as primeiras chaves
+                //inseridas, que ficam no inicio da lista e perto da raiz da ABB
+                consultas[i] = dados[(unsigned long long)(r < n ? r : n - 1) * 2654435761ULL % n];
+                break;
+            }
+            case SEQUENCIAL:
+                consultas[i] = ordenado[i % n];
+                break;
+            case AUSENTES: {
+                int chave;
+                do chave = (int)(aleatorio(estado) % (2 * n)); while (contem(ordenado, n, chave));
+                consultas[i] = chave;
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return consultas;
+}
+
+int comparar_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+double mediana(double* v, int n) {
+    qsort(v, n, sizeof(double), comparar_double);
+    return n % 2 ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2;
+}
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef CONTADORES_H
+#define CONTADORES_H
+
+#include <stdio.h>
+#include <string.h>
+
+/*
+    CONTADORES DE HARDWARE
+
+    Leitura opcional de faltas de cache e de desvios mal previstos pelo
+    perf_event_open do Linux. Em outros sistemas, ou quando o kernel nao
+    permite (perf_event_paranoid, maquinas virtuais), abrir_contadores()
+    retorna 0 e o programa segue medindo so o tempo.
+
+    Os dois contadores formam um grupo, para serem ligados e lidos juntos, e
+    contam apenas o modo usuario.
+*/
+
+#define N_CONTADORES 2
+
+typedef struct {
+    int fd[N_CONTADORES];
+    int ativo;
+} Contadores;
+
+#ifdef __linux__
+
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+static int abrir_evento(unsigned long long evento, int lider) {
+    struct perf_event_attr atributos;
+    memset(&atributos, 0, sizeof(atributos));
+    atributos.size = sizeof(atributos);
+    atributos.type = PERF_TYPE_HARDWARE;
+    atributos.config = evento;
+    atributos.disabled = lider == -1;    //O grupo e ligado pelo lider
+    atributos.exclude_kernel = 1;
+    atributos.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &atributos, 0, -1, lider, 0);
+}
+
+//Retorna 1 se os contadores estiverem disponiveis
+int abrir_contadores(Contadores* c) {
+    c->ativo = 0;
+    c->fd[0] = abrir_evento(PERF_COUNT_HW_CACHE_MISSES, -1);
+    if (c->fd[0] < 0) return 0;
+    c->fd[1] = abrir_evento(PERF_COUNT_HW_BRANCH_MISSES, c->fd[0]);
+    if (c->fd[1] < 0) {
+        close(c->fd[0]);
+        return 0;
+    }
+    c->ativo = 1;
+    return 1;
+}
+
+void iniciar_contadores(Contadores* c) {
+    if (!c->ativo) return;
+    ioctl(c->fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(c->fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+//Para o grupo e le os valores: faltas de cache e desvios mal previstos
+void parar_contadores(Contadores* c, long long valores[N_CONTADORES]) {
+    if (!c->ativo) return;
+    ioctl(c->fd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    for (int i = 0; i < N_CONTADORES; i++) {
+        if (read(c->fd[i], &valores[i], sizeof(long long)) != sizeof(long long)) valores[i] = -1;
+    }
+}
+
+void fechar_contadores(Contadores* c) {
+    if (!c->ativo) return;
+    for (int i = 0; i < N_CONTADORES; i++) close(c->fd[i]);
+    c->ativo = 0;
+}
+
+#else
+
+int abrir_contadores(Contadores* c) { c->ativo = 0; return 0; }
+void iniciar_contadores(Contadores* c) { (void)c; }
+void parar_contadores(Contadores* c, long long valores[N_CONTADORES]) { (void)c; (void)valores; }
+void fechar_contadores(Contadores* c) { (void)c; }
+
+#endif
+
+#endif
@@ -0,0 +1,957 @@
+#ifndef ESTRUTURAS_H
+#define ESTRUTURAS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+/*
+    ESTRUTURAS DE BUSCA
+
+    Todas as estruturas comparadas ficam atras da mesma interface (Estrutura):
+    construir a partir de um vetor de chaves em qualquer ordem, buscar uma
+    chave e liberar. As chaves sao inteiros nao negativos e podem se repetir.
+
+      - lista encadeada e ABB sem balanceamento (as estruturas originais)
+      - as mesmas lista e ABB com os nos em uma arena, e a ABB construida de
+        chaves ordenadas nos layouts pre-ordem, largura e van Emde Boas
+      - arvore AVL
+      - vetor ordenado com busca binaria sem desvios
+      - vetor no layout de Eytzinger (a ordem de uma heap: filhos de k em 2k e 2k+1)
+      - arvore B+ estatica com nos do tamanho de uma linha de cache
+*/
+
+#define LINHA_CACHE 64
+
+
+//Memoria alinhada a linha de cache (liberar com liberar_alinhado)
+void* alocar_alinhado(size_t bytes) {
+    bytes = (bytes + LINHA_CACHE - 1) / LINHA_CACHE * LINHA_CACHE;
+#ifdef _WIN32
+    return _aligned_malloc(bytes, LINHA_CACHE);
+#else
+    return aligned_alloc(LINHA_CACHE, bytes);
+#endif
+}
+
+void liberar_alinhado(void* p) {
+#ifdef _WIN32
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+//Ordenacao por radix (4 passadas de 8 bits): O(n), importante para construir com 10^8 chaves
+void ordenar_chaves(int* v, long n) {
+    int* aux = (int*)malloc(n * sizeof(int));
+    int* origem = v;
+    int* destino = aux;
+    for (int deslocamento = 0; deslocamento < 32; deslocamento += 8) {
+        long contagem[257] = {0};
+        for (long i = 0; i < n; i++) contagem[(((unsigned int)origem[i] >> deslocamento) & 255) + 1]++;
+        for (int d = 0; d < 256; d++) contagem[d + 1] += contagem[d];
+        for (long i = 0; i < n; i++) destino[contagem[((unsigned int)origem[i] >> deslocamento) & 255]++] = origem[i];
+        int* t = origem;
+        origem = destino;
+        destino = t;
+    }
+    //Numero par de passadas: o resultado ja esta em v
+    free(aux);
+}
+
+//Copia ordenada das chaves
+int* copia_ordenada(const int* chaves, int n) {
+    int* v = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    memcpy(v, chaves, n * sizeof(int));
+    ordenar_chaves(v, n);
+    return v;
+}
+
+/*
+    Arena de nos
+
+    Aloca nos em sequencia dentro de blocos grandes: nos alocados um depois
+    do outro ficam vizinhos na memoria, sem o cabecalho de cada malloc, e a
+    estrutura inteira e liberada de uma vez. Quando o bloco atual enche, um
+    novo bloco com o dobro do tamanho e encadeado.
+*/
+
+typedef struct BlocoArena {
+    struct BlocoArena* anterior;
+    size_t usado, capacidade;
+    char* dados;
+} BlocoArena;
+
+typedef struct {
+    BlocoArena* atual;
+} Arena;
+
+static BlocoArena* novo_bloco_arena(BlocoArena* anterior, size_t capacidade) {
+    BlocoArena* bloco = (BlocoArena*)malloc(sizeof(BlocoArena));
+    bloco->anterior = anterior;
+    bloco->usado = 0;
+    bloco->capacidade = capacidade;
+    bloco->dados = (char*)alocar_alinhado(capacidade);
+    return bloco;
+}
+
+//capacidade e o tamanho do primeiro bloco; com a estimativa certa a estrutura fica em um bloco so
+Arena* criar_arena(size_t capacidade) {
+    Arena* arena = (Arena*)malloc(sizeof(Arena));
+    arena->atual = novo_bloco_arena(NULL, capacidade < LINHA_CACHE ? LINHA_CACHE : capacidade);
+    return arena;
+}
+
+void* alocar_arena(Arena* arena, size_t bytes) {
+    bytes = (bytes + sizeof(void*) - 1) / sizeof(void*) * sizeof(void*);
+    BlocoArena* bloco = arena->atual;
+    if (bloco->usado + bytes > bloco->capacidade) {
+        size_t capacidade = 2 * bloco->capacidade;
+        if (capacidade < bytes) capacidade = bytes;
+        bloco = arena->atual = novo_bloco_arena(bloco, capacidade);
+    }
+    void* p = bloco->dados + bloco->usado;
+    bloco->usado += bytes;
+    return p;
+}
+
+void liberar_arena(Arena* arena) {
+    BlocoArena* bloco = arena->atual;
+    while (bloco != NULL) {
+        BlocoArena* anterior = bloco->anterior;
+        liberar_alinhado(bloco->dados);
+        free(bloco);
+        bloco = anterior;
+    }
+    free(arena);
+}
+
+
+/*
+    Lista encadeada
+*/
+
+typedef struct no {
+    int item;
+    struct no* prox;
+} no;
+
+
+no* criar_no_lista(int valor) {
+    no* novo_no = (no*)malloc(sizeof(no));
+    novo_no->item = valor;
+    novo_no->prox = NULL;
+    return novo_no;
+}
+
+
+void inserir_lista(no** head, int valor) {
+    no* novo_no = criar_no_lista(valor);
+    if (*head == NULL) {
+        *head = novo_no;
+        return;
+    }
+    no* temp = *head;
+    while (temp->prox != NULL)
+        temp = temp->prox;
+    temp->prox = novo_no;
+}
+
+
+int buscar_lista(no* head, int valor, int* comparacoes) {
+    *comparacoes = 0;
+    no* temp = head;
+    while (temp != NULL) {
+        (*comparacoes)++;
+        if (temp->item == valor)
+            return 1;
+        temp = temp->prox;
+    }
+    return 0;
+}
+
+
+void liberar_lista(no* head) {
+    no* temp;
+    while (head != NULL) {
+        temp = head;
+        head = head->prox;
+        free(temp);
+    }
+}
+
+//Mesma lista de inserir_lista em sequencia, mas guardando o fim: O(n) em vez de O(n^2)
+no* construir_lista(const int* chaves, int n) {
+    no* head = NULL;
+    no* fim = NULL;
+    for (int i = 0; i < n; i++) {
+        no* novo_no = criar_no_lista(chaves[i]);
+        if (fim == NULL) head = novo_no;
+        else fim->prox = novo_no;
+        fim = novo_no;
+    }
+    return head;
+}
+
+
+/*
+    Arvore binaria de busca
+*/
+
+typedef struct arvore {
+    int item;
+    struct arvore *esq, *dir;
+} arvore;
+
+
+arvore* criar_no_arvore(int valor) {
+    arvore* novo_no = (arvore*)malloc(sizeof(arvore));
+    novo_no->item = valor;
+    novo_no->esq = novo_no->dir = NULL;
+    return novo_no;
+}
+
+
+arvore* inserir_arvore (arvore* raiz, int valor){
+    if (raiz == NULL) return criar_no_arvore(valor);
+    if (valor < raiz->item){
+        raiz->esq = inserir_arvore(raiz->esq, valor);
+    }else {
+        raiz->dir = inserir_arvore(raiz->dir, valor);
+    }
+    return raiz;
+}
+
+int buscar_arvore (arvore* raiz, int valor, int* comparacoes){
+
+    *comparacoes = 0;
+
+    while (raiz != NULL){
+        (*comparacoes)++;
+        if (valor == raiz->item){
+            return 1;
+        }else if (valor < raiz->item){
+            raiz = raiz->esq;
+        }else {
+            raiz = raiz->dir;
+        }
+
+    }
+
+    return 0;
+}
+
+
+void liberar_arvore(arvore* raiz) {
+    if (raiz != NULL) {
+        liberar_arvore(raiz->esq);
+        liberar_arvore(raiz->dir);
+        free(raiz);
+    }
+}
+
+
+/*
+    Arvore AVL
+*/
+
+typedef struct avl {
+    int item;
+    int altura;
+    struct avl *esq, *dir;
+} avl;
+
+int altura_avl(avl* no_avl) {
+    return no_avl == NULL ? 0 : no_avl->altura;
+}
+
+void atualizar_altura(avl* no_avl) {
+    int e = altura_avl(no_avl->esq), d = altura_avl(no_avl->dir);
+    no_avl->altura = 1 + (e > d ? e : d);
+}
+
+avl* rotacao_direita(avl* raiz) {
+    avl* nova_raiz = raiz->esq;
+    raiz->esq = nova_raiz->dir;
+    nova_raiz->dir = raiz;
+    atualizar_altura(raiz);
+    atualizar_altura(nova_raiz);
+    return nova_raiz;
+}
+
+avl* rotacao_esquerda(avl* raiz) {
+    avl* nova_raiz = raiz->dir;
+    raiz->dir = nova_raiz->esq;
+    nova_raiz->esq = raiz;
+    atualizar_altura(raiz);
+    atualizar_altura(nova_raiz);
+    return nova_raiz;
+}
+
+//Chaves repetidas sao ignoradas
+avl* inserir_avl(avl* raiz, int valor) {
+    if (raiz == NULL) {
+        avl* novo_no = (avl*)malloc(sizeof(avl));
+        novo_no->item = valor;
+        novo_no->altura = 1;
+        novo_no->esq = novo_no->dir = NULL;
+        return novo_no;
+    }
+    if (valor < raiz->item) raiz->esq = inserir_avl(raiz->esq, valor);
+    else if (valor > raiz->item) raiz->dir = inserir_avl(raiz->dir, valor);
+    else return raiz;
+
+    atualizar_altura(raiz);
+    int balanco = altura_avl(raiz->esq) - altura_avl(raiz->dir);
+    if (balanco > 1) {
+        if (valor > raiz->esq->item) raiz->esq = rotacao_esquerda(raiz->esq);
+        return rotacao_direita(raiz);
+    }
+    if (balanco < -1) {
+        if (valor < raiz->dir->item) raiz->dir = rotacao_direita(raiz->dir);
+        return rotacao_esquerda(raiz);
+    }
+    return raiz;
+}
+
+int buscar_avl(const avl* raiz, int valor) {
+    while (raiz != NULL) {
+        if (valor == raiz->item) return 1;
+        raiz = valor < raiz->item ? raiz->esq : raiz->dir;
+    }
+    return 0;
+}
+
+void liberar_avl(avl* raiz) {
+    if (raiz != NULL) {
+        liberar_avl(raiz->esq);
+        liberar_avl(raiz->dir);
+        free(raiz);
+    }
+}
+
+
+/*
+    Nos em arena e construcao a partir de chaves ordenadas
+
+    As mesmas struct no e struct arvore, buscadas pelas mesmas funcoes, mas
+    com os nos em uma arena. Muda so onde cada no fica na memoria:
+
+      - lista e ABB com insercoes aleatorias: os nos ficam na ordem de
+        insercao, como com malloc, mas sem cabecalhos entre eles
+      - ABB construida de chaves ordenadas em O(n) (o no do meio vira a
+        raiz), perfeitamente balanceada, com os nos em uma de tres ordens:
+          pre-ordem:   cada no seguido da sua subarvore esquerda
+          largura:     nivel por nivel, como o layout de Eytzinger
+          van Emde Boas: a arvore e cortada na metade da altura; a parte de
+                       cima e depois cada subarvore de baixo sao gravadas
+                       em sequencia, cada uma no mesmo layout. Qualquer
+                       caminho da raiz a uma folha cruza O(log n / log B)
+                       blocos de B nos, para qualquer B
+*/
+
+typedef struct {
+    no* head;
+    Arena* arena;
+} ListaArena;
+
+ListaArena* construir_lista_arena(const int* chaves, int n) {
+    ListaArena* lista = (ListaArena*)malloc(sizeof(ListaArena));
+    lista->arena = criar_arena((size_t)n * sizeof(no));
+    lista->head = NULL;
+    no* fim = NULL;
+    for (int i = 0; i < n; i++) {
+        no* novo_no = (no*)alocar_arena(lista->arena, sizeof(no));
+        novo_no->item = chaves[i];
+        novo_no->prox = NULL;
+        if (fim == NULL) lista->head = novo_no;
+        else fim->prox = novo_no;
+        fim = novo_no;
+    }
+    return lista;
+}
+
+void liberar_lista_arena(ListaArena* lista) {
+    liberar_arena(lista->arena);
+    free(lista);
+}
+
+
+typedef struct {
+    arvore* raiz;
+    Arena* arena;
+} ArvoreArena;
+
+typedef enum { LAYOUT_PREORDEM, LAYOUT_LARGURA, LAYOUT_VEB } LayoutArvore;
+
+static arvore* criar_no_arena(Arena* arena, int valor) {
+    arvore* novo_no = (arvore*)alocar_arena(arena, sizeof(arvore));
+    novo_no->item = valor;
+    novo_no->esq = novo_no->dir = NULL;
+    return novo_no;
+}
+
+//Mesma arvore de inserir_arvore em sequencia (repetidas vao para a direita)
+ArvoreArena* construir_arvore_arena(const int* chaves, int n) {
+    ArvoreArena* a = (ArvoreArena*)malloc(sizeof(ArvoreArena));
+    a->arena = criar_arena((size_t)n * sizeof(arvore));
+    a->raiz = NULL;
+    for (int i = 0; i < n; i++) {
+        arvore** lugar = &a->raiz;
+        while (*lugar != NULL) lugar = chaves[i] < (*lugar)->item ? &(*lugar)->esq : &(*lugar)->dir;
+        *lugar = criar_no_arena(a->arena, chaves[i]);
+    }
+    return a;
+}
+
+/*
+    Na arvore construida de ordenado[inicio, fim) a raiz e o meio; a
+    subarvore esquerda vem de [inicio, meio) e a direita de (meio, fim).
+    Cada funcao de layout so decide a ordem em que os nos sao alocados:
+    no[i] recebe o no de ordenado[i].
+*/
+static long meio_intervalo(long inicio, long fim) { return inicio + (fim - inicio) / 2; }
+
+static void alocar_preordem(arvore** no_de, const int* ordenado, long inicio, long fim, Arena* arena) {
+    if (inicio >= fim) return;
+    long meio = meio_intervalo(inicio, fim);
+    no_de[meio] = criar_no_arena(arena, ordenado[meio]);
+    alocar_preordem(no_de, ordenado, inicio, meio, arena);
+    alocar_preordem(no_de, ordenado, meio + 1, fim, arena);
+}
+
+static void alocar_largura(arvore** no_de, const int* ordenado, long n, Arena* arena) {
+    //Fila de intervalos; cada no entra nela uma vez
+    long* fila = (long*)malloc(2 * (n + 1) * sizeof(long));
+    long ler = 0, escrever = 0;
+    if (n > 0) {
+        fila[escrever++] = 0;
+        fila[escrever++] = n;
+    }
+    while (ler < escrever) {
+        long inicio = fila[ler++], fim = fila[ler++];
+        long meio = meio_intervalo(inicio, fim);
+        no_de[meio] = criar_no_arena(arena, ordenado[meio]);
+        if (inicio < meio) {
+            fila[escrever++] = inicio;
+            fila[escrever++] = meio;
+        }
+        if (meio + 1 < fim) {
+            fila[escrever++] = meio + 1;
+            fila[escrever++] = fim;
+        }
+    }
+    free(fila);
+}
+
+static void alocar_veb(arvore** no_de, const int* ordenado, long inicio, long fim, int altura, Arena* arena);
+
+//Aloca, da esquerda para a direita, as subarvores que comecam profundidade niveis abaixo de [inicio, fim)
+static void alocar_veb_abaixo(arvore** no_de, const int* ordenado, long inicio, long fim, int profundidade,
+                              int altura, Arena* arena) {
+    if (inicio >= fim) return;
+    if (profundidade == 0) {
+        alocar_veb(no_de, ordenado, inicio, fim, altura, arena);
+        return;
+    }
+    long meio = meio_intervalo(inicio, fim);
+    alocar_veb_abaixo(no_de, ordenado, inicio, meio, profundidade - 1, altura, arena);
+    alocar_veb_abaixo(no_de, ordenado, meio + 1, fim, profundidade - 1, altura, arena);
+}
+
+//Aloca os niveis de 0 a altura - 1 da subarvore de [inicio, fim)
+static void alocar_veb(arvore** no_de, const int* ordenado, long inicio, long fim, int altura, Arena* arena) {
+    if (inicio >= fim || altura == 0) return;
+    if (altura == 1) {
+        long meio = meio_intervalo(inicio, fim);
+        no_de[meio] = criar_no_arena(arena, ordenado[meio]);
+        return;
+    }
+    int cima = altura / 2;
+    alocar_veb(no_de, ordenado, inicio, fim, cima, arena);
+    alocar_veb_abaixo(no_de, ordenado, inicio, fim, cima, altura - cima, arena);
+}
+
+static arvore* ligar_nos(arvore** no_de, long inicio, long fim) {
+    if (inicio >= fim) return NULL;
+    long meio = meio_intervalo(inicio, fim);
+    arvore* raiz = no_de[meio];
+    raiz->esq = ligar_nos(no_de, inicio, meio);
+    raiz->dir = ligar_nos(no_de, meio + 1, fim);
+    return raiz;
+}
+
+//ABB balanceada a partir das chaves (ordenadas por radix, O(n)), com os nos no layout pedido
+ArvoreArena* construir_arvore_ordenada(const int* chaves, int n, LayoutArvore layout) {
+    ArvoreArena* a = (ArvoreArena*)malloc(sizeof(ArvoreArena));
+    a->arena = criar_arena((size_t)n * sizeof(arvore));
+    int* ordenado = copia_ordenada(chaves, n);
+    arvore** no_de = (arvore**)malloc((n > 0 ? n : 1) * sizeof(arvore*));
+
+    int altura = 0;
+    while ((1L << altura) <= n) altura++;
+
+    if (layout == LAYOUT_PREORDEM) alocar_preordem(no_de, ordenado, 0, n, a->arena);
+    else if (layout == LAYOUT_LARGURA) alocar_largura(no_de, ordenado, n, a->arena);
+    else alocar_veb(no_de, ordenado, 0, n, altura, a->arena);
+    a->raiz = ligar_nos(no_de, 0, n);
+
+    free(no_de);
+    free(ordenado);
+    return a;
+}
+
+void liberar_arvore_arena(ArvoreArena* a) {
+    liberar_arena(a->arena);
+    free(a);
+}
+
+
+/*
+    Vetor ordenado com busca binaria sem desvios
+*/
+
+typedef struct {
+    int* v;
+    int n;
+} VetorOrdenado;
+
+VetorOrdenado* construir_vetor(const int* chaves, int n) {
+    VetorOrdenado* vetor = (VetorOrdenado*)malloc(sizeof(VetorOrdenado));
+    vetor->v = copia_ordenada(chaves, n);
+    vetor->n = n;
+    return vetor;
+}
+
+//O intervalo [base, base + n) sempre contem a posicao da chave; o if vira um cmov
+int buscar_vetor(const VetorOrdenado* vetor, int chave) {
+    if (vetor->n == 0) return 0;
+    const int* base = vetor->v;
+    int n = vetor->n;
+    while (n > 1) {
+        int metade = n / 2;
+        base = base[metade] <= chave ? base + metade : base;
+        n -= metade;
+    }
+    return *base == chave;
+}
+
+void liberar_vetor(VetorOrdenado* vetor) {
+    free(vetor->v);
+    free(vetor);
+}
+
+
+/*
+    Layout de Eytzinger: o vetor ordenado na ordem de uma busca em largura da
+    arvore binaria completa. Os primeiros niveis, visitados por todas as
+    buscas, ficam juntos no inicio do vetor.
+*/
+
+typedef struct {
+    int* v;              //v[1..n]; v[0] nao e usado
+    int n;
+} VetorEytzinger;
+
+//Preenche v em ordem simetrica a partir do vetor ordenado; retorna a proxima posicao de ordenado
+static long preencher_eytzinger(int* v, long n, const int* ordenado, long i, long k) {
+    if (k <= n) {
+        i = preencher_eytzinger(v, n, ordenado, i, 2 * k);
+        v[k] = ordenado[i++];
+        i = preencher_eytzinger(v, n, ordenado, i, 2 * k + 1);
+    }
+    return i;
+}
+
+VetorEytzinger* construir_eytzinger(const int* chaves, int n) {
+    VetorEytzinger* e = (VetorEytzinger*)malloc(sizeof(VetorEytzinger));
+    int* ordenado = copia_ordenada(chaves, n);
+    e->v = (int*)alocar_alinhado((n + 1) * sizeof(int));
+    e->n = n;
+    preencher_eytzinger(e->v, n, ordenado, 0, 1);
+    free(ordenado);
+    return e;
+}
+
+int buscar_eytzinger(const VetorEytzinger* e, int chave) {
+    long k = 1;
+    while (k <= e->n) k = 2 * k + (e->v[k] < chave);
+    //Desfaz as descidas a direita feitas depois do ultimo elemento >= chave
+    k >>= __builtin_ffsl(~k);
+    return k != 0 && e->v[k] == chave;
+}
+
+void liberar_eytzinger(VetorEytzinger* e) {
+    liberar_alinhado(e->v);
+    free(e);
+}
+
+
+/*
+    Arvore B+ estatica
+
+    Cada no tem B_CHAVES chaves (uma linha de cache). As folhas guardam as
+    chaves ordenadas; um no interno guarda, para cada filho a partir do
+    segundo, a menor chave daquele filho, e tem B_CHAVES + 1 filhos. Os
+    filhos do no j ficam nas posicoes j * (B_CHAVES + 1) ... do nivel de
+    baixo, entao a arvore nao tem ponteiros. Posicoes vazias recebem
+    INT_MAX, que nunca e buscado.
+
+    Dentro de um no a busca so conta quantas chaves sao <= a procurada, um
+    laco fixo de 16 comparacoes que o compilador vetoriza.
+*/
+
+#define B_CHAVES (LINHA_CACHE / (int)sizeof(int))
+
+typedef struct {
+    int** niveis;        //niveis[0] e a raiz; niveis[altura - 1] sao as folhas
+    int altura;
+} ArvoreBMais;
+
+ArvoreBMais* construir_bmais(const int* chaves, int n) {
+    ArvoreBMais* arvore_b = (ArvoreBMais*)malloc(sizeof(ArvoreBMais));
+    int* ordenado = copia_ordenada(chaves, n);
+
+    //Numero de nos de cada nivel, das folhas para a raiz
+    long nos[32];
+    int altura = 0;
+    nos[0] = (n + B_CHAVES - 1) / B_CHAVES;
+    if (nos[0] == 0) nos[0] = 1;
+    altura = 1;
+    while (nos[altura - 1] > 1) {
+        nos[altura] = (nos[altura - 1] + B_CHAVES) / (B_CHAVES + 1);
+        altura++;
+    }
+
+    arvore_b->altura = altura;
+    arvore_b->niveis = (int**)malloc(altura * sizeof(int*));
+
+    //Folhas
+    int* folhas = (int*)alocar_alinhado(nos[0] * B_CHAVES * sizeof(int));
+    for (long i = 0; i < nos[0] * B_CHAVES; i++) folhas[i] = i < n ? ordenado[i] : INT_MAX;
+    arvore_b->niveis[altura - 1] = folhas;
+
+    //menor[j]: menor chave da subarvore do no j no nivel que acabou de ser montado
+    int* menor = (int*)malloc(nos[0] * sizeof(int));
+    for (long j = 0; j < nos[0]; j++) menor[j] = folhas[j * B_CHAVES];
+
+    for (int h = 1; h < altura; h++) {
+        long filhos = nos[h - 1];
+        int* nivel = (int*)alocar_alinhado(nos[h] * B_CHAVES * sizeof(int));
+        for (long j = 0; j < nos[h]; j++) {
+            for (int c = 1; c <= B_CHAVES; c++) {
+                long filho = j * (B_CHAVES + 1) + c;
+                nivel[j * B_CHAVES + c - 1] = filho < filhos ? menor[filho] : INT_MAX;
+            }
+            menor[j] = menor[j * (B_CHAVES + 1)];
+        }
+        arvore_b->niveis[altura - 1 - h] = nivel;
+    }
+
+    free(menor);
+    free(ordenado);
+    return arvore_b;
+}
+
+//Quantas das B_CHAVES chaves do no sao <= chave
+static inline int posicao_no(const int* no_b, int chave) {
+    int i = 0;
+    for (int t = 0; t < B_CHAVES; t++) i += no_b[t] <= chave;
+    return i;
+}
+
+int buscar_bmais(const ArvoreBMais* arvore_b, int chave) {
+    long j = 0;
+    for (int h = 0; h < arvore_b->altura - 1; h++) {
+        j = j * (B_CHAVES + 1) + posicao_no(arvore_b->niveis[h] + j * B_CHAVES, chave);
+    }
+    const int* folha = arvore_b->niveis[arvore_b->altura - 1] + j * B_CHAVES;
+    int achou = 0;
+    for (int t = 0; t < B_CHAVES; t++) achou |= folha[t] == chave;
+    return achou;
+}
+
+void liberar_bmais(ArvoreBMais* arvore_b) {
+    for (int h = 0; h < arvore_b->altura; h++) liberar_alinhado(arvore_b->niveis[h]);
+    free(arvore_b->niveis);
+    free(arvore_b);
+}
+
+
+/*
+    Busca em lote
+
+    A busca de uma chave e uma cadeia de acessos dependentes: cada no (ou
+    posicao do vetor) so e conhecido depois que o anterior chega da memoria.
+    As funcoes abaixo recebem um lote de chaves e avancam LOTE_GRUPO buscas
+    intercaladas, um passo de cada vez, pedindo com prefetch o proximo no de
+    cada uma. Enquanto uma busca espera a memoria as outras avancam, entao ate
+    LOTE_GRUPO faltas de cache ficam em andamento ao mesmo tempo.
+
+    Na lista e nas arvores com ponteiros as buscas tem comprimentos
+    diferentes: quando uma termina, o seu lugar no grupo passa para a proxima
+    chave do lote. Nos vetores e na B+ todas as buscas dao o mesmo numero de
+    passos e o grupo avanca junto.
+
+    achou[i] recebe 1 se chaves[i] estiver na estrutura e 0 caso contrario.
+*/
+
+#define LOTE_GRUPO 16
+
+//Tamanho do grupo que comeca em inicio
+static inline int tamanho_grupo(int inicio, int n) {
+    return n - inicio < LOTE_GRUPO ? n - inicio : LOTE_GRUPO;
+}
+
+void buscar_lote_lista(const no* head, const int* chaves, int n, unsigned char* achou) {
+    const no* atual[LOTE_GRUPO];
+    int indice[LOTE_GRUPO];
+    int proxima = 0, ativos = 0;
+
+    for (int i = 0; i < LOTE_GRUPO; i++) {
+        indice[i] = proxima < n ? proxima++ : -1;
+        atual[i] = head;
+        if (indice[i] >= 0) ativos++;
+    }
+    while (ativos > 0) {
+        for (int i = 0; i < LOTE_GRUPO; i++) {
+            if (indice[i] < 0) continue;
+            const no* p = atual[i];
+            if (p != NULL && p->item != chaves[indice[i]]) {
+                p = p->prox;
+                __builtin_prefetch(p);
+                atual[i] = p;
+                continue;
+            }
+            //Busca terminada: o lugar passa para a proxima chave, que recomeca do inicio da lista
+            achou[indice[i]] = p != NULL;
+            if (proxima < n) {
+                indice[i] = proxima++;
+                atual[i] = head;
+            } else {
+                indice[i] = -1;
+                ativos--;
+            }
+        }
+    }
+}
+
+void buscar_lote_arvore(const arvore* raiz, const int* chaves, int n, unsigned char* achou) {
+    const arvore* atual[LOTE_GRUPO];
+    int indice[LOTE_GRUPO];
+    int proxima = 0, ativos = 0;
+
+    for (int i = 0; i < LOTE_GRUPO; i++) {
+        indice[i] = proxima < n ? proxima++ : -1;
+        atual[i] = raiz;
+        if (indice[i] >= 0) ativos++;
+    }
+    while (ativos > 0) {
+        for (int i = 0; i < LOTE_GRUPO; i++) {
+            if (indice[i] < 0) continue;
+            const arvore* p = atual[i];
+            int chave = chaves[indice[i]];
+            if (p != NULL && p->item != chave) {
+                p = chave < p->item ? p->esq : p->dir;
+                __builtin_prefetch(p);
+                atual[i] = p;
+                continue;
+            }
+            //Busca terminada: o lugar passa para a proxima chave (a raiz ja esta no cache)
+            achou[indice[i]] = p != NULL;
+            if (proxima < n) {
+                indice[i] = proxima++;
+                atual[i] = raiz;
+            } else {
+                indice[i] = -1;
+                ativos--;
+            }
+        }
+    }
+}
+
+//Mesma busca de buscar_lote_arvore, para os nos da AVL
+void buscar_lote_avl(const avl* raiz, const int* chaves, int n, unsigned char* achou) {
+    const avl* atual[LOTE_GRUPO];
+    int indice[LOTE_GRUPO];
+    int proxima = 0, ativos = 0;
+
+    for (int i = 0; i < LOTE_GRUPO; i++) {
+        indice[i] = proxima < n ? proxima++ : -1;
+        atual[i] = raiz;
+        if (indice[i] >= 0) ativos++;
+    }
+    while (ativos > 0) {
+        for (int i = 0; i < LOTE_GRUPO; i++) {
+            if (indice[i] < 0) continue;
+            const avl* p = atual[i];
+            int chave = chaves[indice[i]];
+            if (p != NULL && p->item != chave) {
+                p = chave < p->item ? p->esq : p->dir;
+                __builtin_prefetch(p);
+                atual[i] = p;
+                continue;
+            }
+            achou[indice[i]] = p != NULL;
+            if (proxima < n) {
+                indice[i] = proxima++;
+                atual[i] = raiz;
+            } else {
+                indice[i] = -1;
+                ativos--;
+            }
+        }
+    }
+}
+
+void buscar_lote_vetor(const VetorOrdenado* vetor, const int* chaves, int n, unsigned char* achou) {
+    const int* base[LOTE_GRUPO];
+    for (int inicio = 0; inicio < n; inicio += LOTE_GRUPO) {
+        int g = tamanho_grupo(inicio, n);
+        if (vetor->n == 0) {
+            memset(achou + inicio, 0, g);
+            continue;
+        }
+        for (int i = 0; i < g; i++) base[i] = vetor->v;
+        int m = vetor->n;
+        while (m > 1) {
+            int metade = m / 2;
+            for (int i = 0; i < g; i++) {
+                base[i] = base[i][metade] <= chaves[inicio + i] ? base[i] + metade : base[i];
+                //Proxima posicao que esta busca vai ler
+                __builtin_prefetch(base[i] + (m - metade) / 2);
+            }
+            m -= metade;
+        }
+        for (int i = 0; i < g; i++) achou[inicio + i] = *base[i] == chaves[inicio + i];
+    }
+}
+
+void buscar_lote_eytzinger(const VetorEytzinger* e, const int* chaves, int n, unsigned char* achou) {
+    long k[LOTE_GRUPO];
+    for (int inicio = 0; inicio < n; inicio += LOTE_GRUPO) {
+        int g = tamanho_grupo(inicio, n);
+        for (int i = 0; i < g; i++) k[i] = 1;
+        //As buscas descem ate a mesma profundidade ou uma a mais
+        int ativos = 1;
+        while (ativos) {
+            ativos = 0;
+            for (int i = 0; i < g; i++) {
+                if (k[i] > e->n) continue;
+                //Os 16 descendentes de k quatro niveis abaixo ocupam uma linha de cache a partir de 16k
+                __builtin_prefetch(e->v + 16 * k[i]);
+                k[i] = 2 * k[i] + (e->v[k[i]] < chaves[inicio + i]);
+                ativos = 1;
+            }
+        }
+        for (int i = 0; i < g; i++) {
+            long pos = k[i] >> __builtin_ffsl(~k[i]);
+            achou[inicio + i] = pos != 0 && e->v[pos] == chaves[inicio + i];
+        }
+    }
+}
+
+void buscar_lote_bmais(const ArvoreBMais* arvore_b, const int* chaves, int n, unsigned char* achou) {
+    long j[LOTE_GRUPO];
+    for (int inicio = 0; inicio < n; inicio += LOTE_GRUPO) {
+        int g = tamanho_grupo(inicio, n);
+        for (int i = 0; i < g; i++) j[i] = 0;
+        for (int h = 0; h < arvore_b->altura - 1; h++) {
+            for (int i = 0; i < g; i++) {
+                j[i] = j[i] * (B_CHAVES + 1) + posicao_no(arvore_b->niveis[h] + j[i] * B_CHAVES, chaves[inicio + i]);
+                __builtin_prefetch(arvore_b->niveis[h + 1] + j[i] * B_CHAVES);
+            }
+        }
+        const int* folhas = arvore_b->niveis[arvore_b->altura - 1];
+        for (int i = 0; i < g; i++) {
+            int a = 0;
+            for (int t = 0; t < B_CHAVES; t++) a |= folhas[j[i] * B_CHAVES + t] == chaves[inicio + i];
+            achou[inicio + i] = a;
+        }
+    }
+}
+
+
+/*
+    Interface comum
+*/
+
+typedef struct {
+    const char* nome;
+    void* (*construir)(const int* chaves, int n);
+    int (*buscar)(const void* estrutura, int chave);
+    void (*liberar)(void* estrutura);
+    void (*buscar_lote)(const void* estrutura, const int* chaves, int n, unsigned char* achou);
+    long maximo;         //Maior n razoavel (a lista busca em O(n))
+} Estrutura;
+
+static void* construir_lista_e(const int* chaves, int n) { return construir_lista(chaves, n); }
+static int buscar_lista_e(const void* s, int chave) { int c; return buscar_lista((no*)s, chave, &c); }
+static void liberar_lista_e(void* s) { liberar_lista((no*)s); }
+static void buscar_lote_lista_e(const void* s, const int* c, int n, unsigned char* a) { buscar_lote_lista((const no*)s, c, n, a); }
+
+static void* construir_lista_arena_e(const int* chaves, int n) { return construir_lista_arena(chaves, n); }
+static int buscar_lista_arena_e(const void* s, int chave) { int c; return buscar_lista(((const ListaArena*)s)->head, chave, &c); }
+static void liberar_lista_arena_e(void* s) { liberar_lista_arena((ListaArena*)s); }
+static void buscar_lote_lista_arena_e(const void* s, const int* c, int n, unsigned char* a) { buscar_lote_lista(((const ListaArena*)s)->head, c, n, a); }
+
+static void* construir_abb_e(const int* chaves, int n) {
+    arvore* raiz = NULL;
+    for (int i = 0; i < n; i++) raiz = inserir_arvore(raiz, chaves[i]);
+    return raiz;
+}
+static int buscar_abb_e(const void* s, int chave) { int c; return buscar_arvore((arvore*)s, chave, &c); }
+static void liberar_abb_e(void* s) { liberar_arvore((arvore*)s); }
+static void buscar_lote_abb_e(const void* s, const int* c, int n, unsigned char* a) { buscar_lote_arvore((const arvore*)s, c, n, a); }
+
+static void* construir_abb_arena_e(const int* chaves, int n) { return construir_arvore_arena(chaves, n); }
+static void* construir_abb_preordem_e(const int* chaves, int n) { return construir_arvore_ordenada(chaves, n, LAYOUT_PREORDEM); }
+static void* construir_abb_largura_e(const int* chaves, int n) { return construir_arvore_ordenada(chaves, n, LAYOUT_LARGURA); }
+static void* construir_abb_veb_e(const int* chaves, int n) { return construir_arvore_ordenada(chaves, n, LAYOUT_VEB); }
+static int buscar_abb_arena_e(const void* s, int chave) { int c; return buscar_arvore(((const ArvoreArena*)s)->raiz, chave, &c); }
+static void liberar_abb_arena_e(void* s) { liberar_arvore_arena((ArvoreArena*)s); }
+static void buscar_lote_abb_arena_e(const void* s, const int* c, int n, unsigned char* a) { buscar_lote_arvore(((const ArvoreArena*)s)->raiz, c, n, a); }
+
+static void* construir_avl_e(const int* chaves, int n) {
+    avl* raiz = NULL;
+    for (int i = 0; i < n; i++) raiz = inserir_avl(raiz, chaves[i]);
+    return raiz;
+}
+static int buscar_avl_e(const void* s, int chave) { return buscar_avl((const avl*)s, chave); }
+static void liberar_avl_e(void* s) { liberar_avl((avl*)s); }
+static void buscar_lote_avl_e(const void* s, const int* c, int n, unsigned char* a) { buscar_lote_avl((const avl*)s, c, n, a); }
+
+static void* construir_vetor_e(const int* chaves, int n) { return construir_vetor(chaves, n); }
+static int buscar_vetor_e(const void* s, int chave) { return buscar_vetor((const VetorOrdenado*)s, chave); }
+static void liberar_vetor_e(void* s) { liberar_vetor((VetorOrdenado*)s); }
+static void buscar_lote_vetor_e(const void* s, const int* c, int n, unsigned char* a) { buscar_lote_vetor((const VetorOrdenado*)s, c, n, a); }
+
+static void* construir_eytzinger_e(const int* chaves, int n) { return construir_eytzinger(chaves, n); }
+static int buscar_eytzinger_e(const void* s, int chave) { return buscar_eytzinger((const VetorEytzinger*)s, chave); }
+static void liberar_eytzinger_e(void* s) { liberar_eytzinger((VetorEytzinger*)s); }
+static void buscar_lote_eytzinger_e(const void* s, const int* c, int n, unsigned char* a) { buscar_lote_eytzinger((const VetorEytzinger*)s, c, n, a); }
+
+static void* construir_bmais_e(const int* chaves, int n) { return construir_bmais(chaves, n); }
+static int buscar_bmais_e(const void* s, int chave) { return buscar_bmais((const ArvoreBMais*)s, chave); }
+static void liberar_bmais_e(void* s) { liberar_bmais((ArvoreBMais*)s); }
+static void buscar_lote_bmais_e(const void* s, const int* c, int n, unsigned char* a) { buscar_lote_bmais((const ArvoreBMais*)s, c, n, a); }
+
+const Estrutura ESTRUTURAS[] = {
+    {"lista",        construir_lista_e,        buscar_lista_e,       liberar_lista_e,       buscar_lote_lista_e,       100000},
+    {"lista_arena",  construir_lista_arena_e,  buscar_lista_arena_e, liberar_lista_arena_e, buscar_lote_lista_arena_e, 100000},
+    //Arvores com ponteiros: ~40 bytes por no contando o cabecalho do malloc (24 na arena)
+    {"abb",          construir_abb_e,          buscar_abb_e,         liberar_abb_e,         buscar_lote_abb_e,         20000000},
+    {"abb_arena",    construir_abb_arena_e,    buscar_abb_arena_e,   liberar_abb_arena_e,   buscar_lote_abb_arena_e,   20000000},
+    {"abb_preordem", construir_abb_preordem_e, buscar_abb_arena_e,   liberar_abb_arena_e,   buscar_lote_abb_arena_e,   20000000},
+    {"abb_largura",  construir_abb_largura_e,  buscar_abb_arena_e,   liberar_abb_arena_e,   buscar_lote_abb_arena_e,   20000000},
+    {"abb_veb",      construir_abb_veb_e,      buscar_abb_arena_e,   liberar_abb_arena_e,   buscar_lote_abb_arena_e,   20000000},
+    {"avl",          construir_avl_e,          buscar_avl_e,         liberar_avl_e,         buscar_lote_avl_e,         20000000},
+    {"vetor",        construir_vetor_e,        buscar_vetor_e,       liberar_vetor_e,       buscar_lote_vetor_e,       100000000},
+    {"eytzinger",    construir_eytzinger_e,    buscar_eytzinger_e,   liberar_eytzinger_e,   buscar_lote_eytzinger_e,   100000000},
+    {"bmais",        construir_bmais_e,        buscar_bmais_e,       liberar_bmais_e,       buscar_lote_bmais_e,       100000000},
+};
+#define N_ESTRUTURAS ((int)(sizeof(ESTRUTURAS) / sizeof(ESTRUTURAS[0])))
+
+#endif
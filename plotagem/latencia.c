@@ -0,0 +1,172 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "estruturas.h"
+#include "contadores.h"
+#include "consultas.h"
+
+/*
+    LATENCIA DE BUSCA
+
+    Para cada tamanho n (potencias de 10 entre o minimo e o maximo) gera n
+    chaves aleatorias em [0, 2n), como contagem.c, constroi cada estrutura e
+    mede o tempo por busca em cada padrao de acesso (uniforme, zipf,
+    sequencial e ausentes; ver consultas.h).
+
+    Cada busca usa o resultado da anterior para formar a chave (somando zero),
+    entao o processador nao consegue sobrepor buscas: o tempo medido e a
+    latencia de uma busca, nao a vazao. Antes das medicoes ha uma passada de
+    aquecimento; depois sao feitas varias repeticoes e a saida traz a mediana,
+    o minimo e o maximo. Com --perf, le tambem faltas de cache e desvios mal
+    previstos por busca (mediana das repeticoes), quando o sistema permite.
+
+    Uso: latencia [n_maximo] [opcoes]
+      --min N            menor n (padrao 1000)
+      --max N            maior n (padrao 10000000; ate 100000000)
+      --repeticoes R     repeticoes medidas por padrao (padrao 5)
+      --buscas B         buscas por repeticao (padrao 1000000)
+      --padroes lista    ex.: uniforme,zipf (padrao: todos)
+      --estruturas lista ex.: avl,bmais (padrao: todas)
+      --perf             le os contadores de hardware
+
+    Saida (CSV longo, em stdout): estrutura,n,padrao,metrica,valor
+      metricas: construcao_s (padrao "-"), ns_por_busca, ns_min, ns_max,
+                cache_misses_por_busca, branch_misses_por_busca
+*/
+
+#define NUM_BUSCAS_LATENCIA 1000000
+
+
+typedef struct {
+    double ns;
+    double contadores[N_CONTADORES];    //Por busca
+} Medida;
+
+//Uma passada pelas consultas; retorna 0 se algum resultado for diferente do esperado
+int medir(const Estrutura* estrutura, const void* s, const int* consultas, int num, int esperado,
+          Contadores* contadores, Medida* medida) {
+    long long valores[N_CONTADORES] = {0};
+    long encontrados = 0;
+    int r = esperado;
+
+    iniciar_contadores(contadores);
+    double inicio = agora();
+    for (int i = 0; i < num; i++) {
+        //r - esperado e sempre zero, mas cria a dependencia entre buscas consecutivas
+        r = estrutura->buscar(s, consultas[i] + (r - esperado)) != 0;
+        encontrados += r;
+    }
+    double tempo = agora() - inicio;
+    parar_contadores(contadores, valores);
+
+    medida->ns = tempo * 1e9 / num;
+    for (int c = 0; c < N_CONTADORES; c++) medida->contadores[c] = (double)valores[c] / num;
+    return encontrados == (long)esperado * num;
+}
+
+int main(int argc, char* argv[]) {
+    long n_minimo = 1000, n_maximo = 10000000;
+    int repeticoes = 5, num_buscas = NUM_BUSCAS_LATENCIA, usar_perf = 0;
+    const char* padroes = NULL;
+    const char* estruturas = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        int tem_valor = i + 1 < argc;
+        if (strcmp(argv[i], "--min") == 0 && tem_valor) n_minimo = atol(argv[++i]);
+        else if (strcmp(argv[i], "--max") == 0 && tem_valor) n_maximo = atol(argv[++i]);
+        else if (strcmp(argv[i], "--repeticoes") == 0 && tem_valor) repeticoes = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--buscas") == 0 && tem_valor) num_buscas = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--padroes") == 0 && tem_valor) padroes = argv[++i];
+        else if (strcmp(argv[i], "--estruturas") == 0 && tem_valor) estruturas = argv[++i];
+        else if (strcmp(argv[i], "--perf") == 0) usar_perf = 1;
+        else if (argv[i][0] != '-') n_maximo = atol(argv[i]);
+        else {
+            fprintf(stderr, "Opcao invalida: %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (n_minimo < 1 || n_maximo > 100000000 || repeticoes < 1 || num_buscas < 1) {
+        fprintf(stderr, "Parametros invalidos.\n");
+        return 1;
+    }
+
+    Contadores contadores;
+    contadores.ativo = 0;
+    if (usar_perf && !abrir_contadores(&contadores))
+        fprintf(stderr, "Aviso: contadores de hardware indisponiveis; medindo so o tempo.\n");
+
+    unsigned long long estado = 0x9E3779B97F4A7C15ULL;
+    double* amostras = (double*)malloc(repeticoes * sizeof(double));
+    Medida* medidas = (Medida*)malloc(repeticoes * sizeof(Medida));
+
+    printf("estrutura,n,padrao,metrica,valor\n");
+    for (long n = n_minimo; n <= n_maximo; n *= 10) {
+        int* dados = (int*)malloc(n * sizeof(int));
+        for (long i = 0; i < n; i++) dados[i] = (int)(aleatorio(&estado) % (2 * n));
+
+        //Mesmas consultas para todas as estruturas
+        int* consultas[N_PADROES] = {NULL};
+        int* ordenado = copia_ordenada(dados, (int)n);
+        for (int p = 0; p < N_PADROES; p++) {
+            if (na_lista(padroes, NOMES_PADROES[p]))
+                consultas[p] = gerar_consultas((Padrao)p, dados, ordenado, n, num_buscas, &estado);
+        }
+        free(ordenado);
+
+        for (int e = 0; e < N_ESTRUTURAS; e++) {
+            const Estrutura* estrutura = &ESTRUTURAS[e];
+            if (n > estrutura->maximo || !na_lista(estruturas, estrutura->nome)) continue;
+
+            double inicio = agora();
+            void* s = estrutura->construir(dados, (int)n);
+            printf("%s,%ld,-,construcao_s,%.4f\n", estrutura->nome, n, agora() - inicio);
+
+            //A lista e O(n) por busca: reduz o numero de buscas para manter o tempo razoavel
+            int num = num_buscas;
+            if (strncmp(estrutura->nome, "lista", 5) == 0 && n > 100) num = (int)(num_buscas / (n / 100));
+            if (num < 1) num = 1;
+
+            for (int p = 0; p < N_PADROES; p++) {
+                if (consultas[p] == NULL) continue;
+                int esperado = p != AUSENTES;
+
+                Medida aquecimento;
+                int correto = medir(estrutura, s, consultas[p], num, esperado, &contadores, &aquecimento);
+                for (int r = 0; r < repeticoes && correto; r++)
+                    correto = medir(estrutura, s, consultas[p], num, esperado, &contadores, &medidas[r]);
+                if (!correto) {
+                    fprintf(stderr, "Erro: %s deu resultado errado no padrao %s com n = %ld.\n",
+                            estrutura->nome, NOMES_PADROES[p], n);
+                    return 1;
+                }
+
+                for (int r = 0; r < repeticoes; r++) amostras[r] = medidas[r].ns;
+                double central = mediana(amostras, repeticoes);
+                printf("%s,%ld,%s,ns_por_busca,%.2f\n", estrutura->nome, n, NOMES_PADROES[p], central);
+                printf("%s,%ld,%s,ns_min,%.2f\n", estrutura->nome, n, NOMES_PADROES[p], amostras[0]);
+                printf("%s,%ld,%s,ns_max,%.2f\n", estrutura->nome, n, NOMES_PADROES[p], amostras[repeticoes - 1]);
+
+                if (contadores.ativo) {
+                    const char* nomes[N_CONTADORES] = {"cache_misses_por_busca", "branch_misses_por_busca"};
+                    for (int c = 0; c < N_CONTADORES; c++) {
+                        for (int r = 0; r < repeticoes; r++) amostras[r] = medidas[r].contadores[c];
+                        printf("%s,%ld,%s,%s,%.3f\n", estrutura->nome, n, NOMES_PADROES[p], nomes[c],
+                               mediana(amostras, repeticoes));
+                    }
+                }
+                fflush(stdout);
+            }
+            estrutura->liberar(s);
+        }
+
+        free(dados);
+        for (int p = 0; p < N_PADROES; p++) free(consultas[p]);
+    }
+
+    fechar_contadores(&contadores);
+    free(amostras);
+    free(medidas);
+    return 0;
+}
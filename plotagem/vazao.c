@@ -0,0 +1,216 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "estruturas.h"
+#include "consultas.h"
+
+/*
+    VAZAO DE BUSCA
+
+    Mede quantas buscas por segundo cada estrutura atende quando as buscas
+    sao independentes, como num servico que recebe muitas consultas ao mesmo
+    tempo (latencia.c mede o contrario: uma busca de cada vez):
+
+      - individual: uma chamada de buscar() por chave; o processador so
+                    sobrepoe buscas vizinhas dentro da sua janela de execucao
+      - lote:       buscar_lote() com LOTE_GRUPO buscas intercaladas e prefetch
+
+    Cada modo roda com 1, 2, 4, ... threads ate o maximo pedido. As buscas sao
+    divididas em partes iguais, uma por thread, todas sobre a mesma estrutura
+    (somente leitura, sem sincronizacao). Cada thread anota quando saiu da
+    largada e quando terminou; o tempo da rodada vai da primeira largada ao
+    ultimo termino. Contagens de threads acima do numero de processadores
+    sao puladas: threads disputando o mesmo processador nao medem escala.
+
+    Uso: vazao [n_maximo] [opcoes]
+      --min N            menor n (padrao 1000)
+      --max N            maior n (padrao 10000000; ate 100000000)
+      --threads T        maximo de threads (padrao e limite: processadores disponiveis)
+      --repeticoes R     repeticoes por medicao (padrao 5)
+      --buscas B         total de buscas por repeticao (padrao 4000000)
+      --padroes lista    ex.: uniforme,ausentes (padrao: uniforme)
+      --estruturas lista ex.: avl,bmais (padrao: todas)
+
+    Saida (CSV longo, em stdout): estrutura,n,padrao,modo,threads,metrica,valor
+      metricas: mbuscas_por_s (mediana), aceleracao (em relacao a 1 thread
+                no mesmo modo)
+*/
+
+#define NUM_BUSCAS_VAZAO 4000000
+
+typedef struct {
+    const Estrutura* estrutura;
+    const void* s;
+    const int* consultas;
+    unsigned char* achou;
+    int inicio, fim;
+    int em_lote;
+    pthread_barrier_t* largada;
+    double comeco, termino;          //Anotados pela propria thread
+} Parte;
+
+void* executar_parte(void* arg) {
+    Parte* parte = (Parte*)arg;
+    pthread_barrier_wait(parte->largada);
+    parte->comeco = agora();
+    if (parte->em_lote) {
+        parte->estrutura->buscar_lote(parte->s, parte->consultas + parte->inicio, parte->fim - parte->inicio,
+                                      parte->achou + parte->inicio);
+    } else {
+        for (int i = parte->inicio; i < parte->fim; i++)
+            parte->achou[i] = parte->estrutura->buscar(parte->s, parte->consultas[i]) != 0;
+    }
+    parte->termino = agora();
+    return NULL;
+}
+
+//Uma rodada com n_threads threads; retorna os segundos gastos
+double rodada(const Estrutura* estrutura, const void* s, const int* consultas, int num, unsigned char* achou,
+              int em_lote, int n_threads) {
+    pthread_t* threads = (pthread_t*)malloc(n_threads * sizeof(pthread_t));
+    Parte* partes = (Parte*)malloc(n_threads * sizeof(Parte));
+    pthread_barrier_t largada;
+    pthread_barrier_init(&largada, NULL, n_threads + 1);
+
+    for (int t = 0; t < n_threads; t++) {
+        Parte* parte = &partes[t];
+        parte->estrutura = estrutura;
+        parte->s = s;
+        parte->consultas = consultas;
+        parte->achou = achou;
+        parte->inicio = (int)((long)num * t / n_threads);
+        parte->fim = (int)((long)num * (t + 1) / n_threads);
+        parte->em_lote = em_lote;
+        parte->largada = &largada;
+        pthread_create(&threads[t], NULL, executar_parte, parte);
+    }
+
+    //Libera as threads so depois de todas existirem; o tempo e o das proprias threads
+    pthread_barrier_wait(&largada);
+    for (int t = 0; t < n_threads; t++) pthread_join(threads[t], NULL);
+    double comeco = partes[0].comeco, termino = partes[0].termino;
+    for (int t = 1; t < n_threads; t++) {
+        if (partes[t].comeco < comeco) comeco = partes[t].comeco;
+        if (partes[t].termino > termino) termino = partes[t].termino;
+    }
+    double tempo = termino - comeco;
+
+    pthread_barrier_destroy(&largada);
+    free(threads);
+    free(partes);
+    return tempo;
+}
+
+
+int main(int argc, char* argv[]) {
+    long n_minimo = 1000, n_maximo = 10000000;
+    int repeticoes = 5, num_buscas = NUM_BUSCAS_VAZAO;
+    int processadores = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int max_threads = processadores;
+    const char* padroes = "uniforme";
+    const char* estruturas = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        int tem_valor = i + 1 < argc;
+        if (strcmp(argv[i], "--min") == 0 && tem_valor) n_minimo = atol(argv[++i]);
+        else if (strcmp(argv[i], "--max") == 0 && tem_valor) n_maximo = atol(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && tem_valor) max_threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--repeticoes") == 0 && tem_valor) repeticoes = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--buscas") == 0 && tem_valor) num_buscas = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--padroes") == 0 && tem_valor) padroes = argv[++i];
+        else if (strcmp(argv[i], "--estruturas") == 0 && tem_valor) estruturas = argv[++i];
+        else if (argv[i][0] != '-') n_maximo = atol(argv[i]);
+        else {
+            fprintf(stderr, "Opcao invalida: %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (n_minimo < 1 || n_maximo > 100000000 || repeticoes < 1 || num_buscas < 1 || max_threads < 1) {
+        fprintf(stderr, "Parametros invalidos.\n");
+        return 1;
+    }
+
+    if (processadores >= 1 && max_threads > processadores) {
+        fprintf(stderr, "Aviso: %d threads pedidas, mas so ha %d processador(es); medindo ate %d.\n",
+                max_threads, processadores, processadores);
+        max_threads = processadores;
+    }
+
+    //1, 2, 4, ... e o proprio maximo
+    int contagens[32], n_contagens = 0;
+    for (int t = 1; t < max_threads && n_contagens < 31; t *= 2) contagens[n_contagens++] = t;
+    contagens[n_contagens++] = max_threads;
+
+    const char* NOMES_MODOS[2] = {"individual", "lote"};
+    unsigned long long estado = 0x9E3779B97F4A7C15ULL;
+    double* amostras = (double*)malloc(repeticoes * sizeof(double));
+    unsigned char* achou = (unsigned char*)malloc(num_buscas);
+
+    printf("estrutura,n,padrao,modo,threads,metrica,valor\n");
+    for (long n = n_minimo; n <= n_maximo; n *= 10) {
+        int* dados = (int*)malloc(n * sizeof(int));
+        for (long i = 0; i < n; i++) dados[i] = (int)(aleatorio(&estado) % (2 * n));
+
+        int* consultas[N_PADROES] = {NULL};
+        int* ordenado = copia_ordenada(dados, (int)n);
+        for (int p = 0; p < N_PADROES; p++) {
+            if (na_lista(padroes, NOMES_PADROES[p]))
+                consultas[p] = gerar_consultas((Padrao)p, dados, ordenado, n, num_buscas, &estado);
+        }
+        free(ordenado);
+
+        for (int e = 0; e < N_ESTRUTURAS; e++) {
+            const Estrutura* estrutura = &ESTRUTURAS[e];
+            if (n > estrutura->maximo || !na_lista(estruturas, estrutura->nome)) continue;
+            void* s = estrutura->construir(dados, (int)n);
+
+            //A lista e O(n) por busca: reduz o numero de buscas para manter o tempo razoavel
+            int num = num_buscas;
+            if (strncmp(estrutura->nome, "lista", 5) == 0 && n > 100) num = (int)(num_buscas / (n / 100));
+            if (num < 1) num = 1;
+
+            for (int p = 0; p < N_PADROES; p++) {
+                if (consultas[p] == NULL) continue;
+                long esperado = p != AUSENTES ? num : 0;
+
+                for (int modo = 0; modo < 2; modo++) {
+                    double base = 0;
+                    //Aquecimento com uma thread
+                    rodada(estrutura, s, consultas[p], num, achou, modo, 1);
+                    for (int c = 0; c < n_contagens; c++) {
+                        for (int r = 0; r < repeticoes; r++) {
+                            memset(achou, 0, num);
+                            double tempo = rodada(estrutura, s, consultas[p], num, achou, modo, contagens[c]);
+                            long encontrados = 0;
+                            for (int i = 0; i < num; i++) encontrados += achou[i];
+                            if (encontrados != esperado) {
+                                fprintf(stderr, "Erro: %s (%s) encontrou %ld de %ld chaves no padrao %s com n = %ld.\n",
+                                        estrutura->nome, NOMES_MODOS[modo], encontrados, esperado, NOMES_PADROES[p], n);
+                                return 1;
+                            }
+                            amostras[r] = num / tempo / 1e6;
+                        }
+
+                        double vazao = mediana(amostras, repeticoes);
+                        if (c == 0) base = vazao;
+                        printf("%s,%ld,%s,%s,%d,mbuscas_por_s,%.3f\n", estrutura->nome, n, NOMES_PADROES[p],
+                               NOMES_MODOS[modo], contagens[c], vazao);
+                        printf("%s,%ld,%s,%s,%d,aceleracao,%.3f\n", estrutura->nome, n, NOMES_PADROES[p],
+                               NOMES_MODOS[modo], contagens[c], vazao / base);
+                        fflush(stdout);
+                    }
+                }
+            }
+            estrutura->liberar(s);
+        }
+
+        free(dados);
+        for (int p = 0; p < N_PADROES; p++) free(consultas[p]);
+    }
+
+    free(amostras);
+    free(achou);
+    return 0;
+}
@@ -0,0 +1,294 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include "formula.h"
+#include "cubos.h"
+#include "solver.h"
+#include "geradores.h"
+
+/*
+    BENCHMARK DO SAT SOLVER
+
+    Gera uma bateria de instancias (k-SAT aleatorio, casa dos pombos,
+    paridade e coloracao) e resolve cada uma com varias configuracoes do
+    solver. Cada execucao roda em um processo filho separado, o que permite
+    medir o pico de memoria de forma isolada e encerrar execucoes que
+    estourem o tempo limite.
+
+    Saida (CSV):
+    instancia,variaveis,clausulas,configuracao,resultado,esperado,correto,tempo_s,memoria_kb
+
+    Uso: benchmark [--tempo S] [--escala N] [--threads N] [--saida ARQ] [--exportar DIR]
+*/
+
+#define MAX_INSTANCIAS 64
+#define LIMITE_VARS_BACKTRACKING 45   //dpll e cubos so rodam em instancias pequenas
+
+typedef enum {
+    CONFIG_CDCL,
+    CONFIG_CDCL_SEM_REINICIOS,
+    CONFIG_CDCL_SEM_REDUCAO,
+    CONFIG_CUBOS,
+    CONFIG_DPLL
+} Configuracao;
+
+const char* NOMES_CONFIG[] = {"cdcl", "cdcl-sem-reinicios", "cdcl-sem-reducao", "cubos", "dpll"};
+#define N_CONFIGS 5
+
+
+//Resposta do processo filho
+typedef struct {
+    int resultado;          //SOLVER_SAT, SOLVER_UNSAT ou SOLVER_DESCONHECIDO
+    bool modelo_valido;
+    double tempo;
+    int n_variaveis, n_clausulas;
+} Execucao;
+
+
+double agora(void) {
+    struct timeval t;
+    gettimeofday(&t, NULL);
+    return t.tv_sec + t.tv_usec * 1e-6;
+}
+
+bool verificar_modelo(const Formula* formula, const Interpretacao* interpretacao) {
+    for (int i = 0; i < formula->n_clausulas; i++) {
+        if (!clausula_sat(&formula->clausulas[i], interpretacao)) return false;
+    }
+    return true;
+}
+
+int montar_suite(Instancia* suite, int escala) {
+    int n = 0;
+    for (int tamanho = 50; tamanho <= 150; tamanho += 50) {
+        for (unsigned int semente = 1; semente <= 3; semente++) {
+            Instancia* inst = &suite[n++];
+            *inst = (Instancia){GERADOR_KSAT, 3, tamanho * escala, 4.26, semente, ""};
+            snprintf(inst->nome, sizeof(inst->nome), "ksat3-n%d-s%u", inst->b, semente);
+        }
+    }
+    for (int casas = 6; casas <= 8; casas++) {
+        Instancia* inst = &suite[n++];
+        *inst = (Instancia){GERADOR_POMBOS, casas + escala - 1, 0, 0, 0, ""};
+        snprintf(inst->nome, sizeof(inst->nome), "pombos-%d", inst->a);
+    }
+    for (int tamanho = 10; tamanho <= 30; tamanho += 10) {
+        for (int satisfativel = 0; satisfativel <= 1; satisfativel++) {
+            Instancia* inst = &suite[n++];
+            *inst = (Instancia){GERADOR_PARIDADE, tamanho * escala, satisfativel, 0, 7, ""};
+            snprintf(inst->nome, sizeof(inst->nome), "paridade-%d-%s", inst->a, satisfativel ? "sat" : "unsat");
+        }
+    }
+    for (int vertices = 50; vertices <= 150; vertices += 50) {
+        Instancia* inst = &suite[n++];
+        *inst = (Instancia){GERADOR_COLORACAO, vertices * escala, 3, 2.3, 11, ""};
+        snprintf(inst->nome, sizeof(inst->nome), "coloracao3-v%d", inst->a);
+    }
+    return n;
+}
+
+//Executado no processo filho: gera a instancia, resolve e verifica o modelo
+Execucao executar(const Instancia* inst, Configuracao config, int n_threads, double limite_tempo) {
+    Esperado esperado;
+    Formula F = gerar_instancia(inst, &esperado);
+
+    Execucao e;
+    e.n_variaveis = F.n_variaveis;
+    e.n_clausulas = F.n_clausulas;
+    e.modelo_valido = true;
+
+    Interpretacao I;
+    I.n_variaveis = F.n_variaveis;
+    I.valores = (int*)malloc((I.n_variaveis + 1) * sizeof(int));
+    for (int i = 1; i <= I.n_variaveis; i++) I.valores[i] = -1;
+
+    double inicio = agora();
+    if (config == CONFIG_DPLL) {
+        e.resultado = sat(&F, &I) ? SOLVER_SAT : SOLVER_UNSAT;
+    } else if (config == CONFIG_CUBOS) {
+        e.resultado = sat_cubos(&F, &I, n_threads) ? SOLVER_SAT : SOLVER_UNSAT;
+    } else {
+        Solver* s = solver_criar();
+        s->limite_tempo = limite_tempo;
+        s->usar_reinicios = config != CONFIG_CDCL_SEM_REINICIOS;
+        s->usar_reducao = config != CONFIG_CDCL_SEM_REDUCAO;
+        e.resultado = solver_adicionar_formula(s, &F) ? solver_resolver(s, NULL, 0) : SOLVER_UNSAT;
+        for (int i = 1; i <= I.n_variaveis; i++) I.valores[i] = solver_valor(s, i);
+        solver_liberar(s);
+    }
+    e.tempo = agora() - inicio;
+
+    if (e.resultado == SOLVER_SAT) e.modelo_valido = verificar_modelo(&F, &I);
+
+    free(I.valores);
+    liberar_formula(&F);
+    return e;
+}
+
+typedef enum {
+    FILHO_TERMINOU,
+    FILHO_ESTOUROU,     //Encerrado pelo alarme do limite de tempo
+    FILHO_FALHOU        //Outro sinal (SIGSEGV, abort...) ou codigo de saida diferente de 0
+} DesfechoFilho;
+
+//Roda uma configuracao em um processo filho; *e so e valido se o filho terminou
+DesfechoFilho executar_isolado(const Instancia* inst, Configuracao config, int n_threads, int limite_tempo,
+                               Execucao* e, long* memoria_kb) {
+    int canal[2];
+    if (pipe(canal) != 0) {
+        perror("pipe");
+        exit(1);
+    }
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(canal[0]);
+        alarm(limite_tempo + 1);    //Garante o fim de dpll e cubos, que nao tem limite proprio
+        Execucao r = executar(inst, config, n_threads, limite_tempo);
+        if (write(canal[1], &r, sizeof(r)) != sizeof(r)) _exit(1);
+        _exit(0);
+    }
+
+    close(canal[1]);
+    bool ok = read(canal[0], e, sizeof(*e)) == sizeof(*e);
+    close(canal[0]);
+
+    int status;
+    struct rusage uso;
+    if (wait4(pid, &status, 0, &uso) < 0) {
+        perror("wait4");
+        exit(1);
+    }
+    *memoria_kb = uso.ru_maxrss;
+
+    if (WIFSIGNALED(status) && WTERMSIG(status) == SIGALRM) return FILHO_ESTOUROU;
+    if (WIFSIGNALED(status)) {
+        fprintf(stderr, "%s (%s): processo encerrado pelo sinal %d.\n", inst->nome, NOMES_CONFIG[config],
+                WTERMSIG(status));
+        return FILHO_FALHOU;
+    }
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || !ok) {
+        fprintf(stderr, "%s (%s): processo terminou com codigo %d.\n", inst->nome, NOMES_CONFIG[config],
+                WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+        return FILHO_FALHOU;
+    }
+    return FILHO_TERMINOU;
+}
+
+int main(int argc, char* argv[]) {
+    int limite_tempo = 10, escala = 1, n_threads = 4;
+    const char* arquivo_saida = NULL;
+    const char* dir_exportar = NULL;
+#ifdef _SC_NPROCESSORS_ONLN
+    n_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--tempo") == 0 && i + 1 < argc) limite_tempo = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--escala") == 0 && i + 1 < argc) escala = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) n_threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--saida") == 0 && i + 1 < argc) arquivo_saida = argv[++i];
+        else if (strcmp(argv[i], "--exportar") == 0 && i + 1 < argc) dir_exportar = argv[++i];
+        else {
+            printf("Opcao invalida: %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (escala < 1) escala = 1;
+
+    Instancia suite[MAX_INSTANCIAS];
+    int n_instancias = montar_suite(suite, escala);
+
+    //Apenas grava as instancias em DIR/<nome>.cnf
+    if (dir_exportar != NULL) {
+        for (int i = 0; i < n_instancias; i++) {
+            char nome[512];
+            snprintf(nome, sizeof(nome), "%s/%s.cnf", dir_exportar, suite[i].nome);
+            FILE* arquivo = fopen(nome, "w");
+            if (arquivo == NULL) {
+                printf("Erro ao criar o arquivo %s.\n", nome);
+                return 1;
+            }
+            Esperado esperado;
+            Formula F = gerar_instancia(&suite[i], &esperado);
+            escrever_formula(&F, arquivo);
+            liberar_formula(&F);
+            fclose(arquivo);
+        }
+        printf("%d instancias gravadas em %s.\n", n_instancias, dir_exportar);
+        return 0;
+    }
+
+    FILE* saida = stdout;
+    if (arquivo_saida != NULL) {
+        saida = fopen(arquivo_saida, "w");
+        if (saida == NULL) {
+            printf("Erro ao abrir arquivo para escrita.\n");
+            return 1;
+        }
+    }
+
+    fprintf(saida, "instancia,variaveis,clausulas,configuracao,resultado,esperado,correto,tempo_s,memoria_kb\n");
+    int erros = 0;
+
+    for (int i = 0; i < n_instancias; i++) {
+        Esperado esperado;
+        Formula F = gerar_instancia(&suite[i], &esperado);
+        int n_variaveis = F.n_variaveis, n_clausulas = F.n_clausulas;
+        liberar_formula(&F);
+
+        //Sem resposta conhecida, a primeira configuracao que decidir serve de referencia
+        int referencia = esperado == ESPERADO_SAT ? SOLVER_SAT :
+                         esperado == ESPERADO_UNSAT ? SOLVER_UNSAT : SOLVER_DESCONHECIDO;
+
+        for (int c = 0; c < N_CONFIGS; c++) {
+            if ((c == CONFIG_DPLL || c == CONFIG_CUBOS) && n_variaveis > LIMITE_VARS_BACKTRACKING) continue;
+
+            Execucao e;
+            long memoria_kb;
+            DesfechoFilho desfecho = executar_isolado(&suite[i], (Configuracao)c, n_threads, limite_tempo,
+                                                      &e, &memoria_kb);
+            if (desfecho != FILHO_TERMINOU) {
+                e.resultado = SOLVER_DESCONHECIDO;
+                e.tempo = limite_tempo;
+                e.modelo_valido = true;
+            }
+
+            const char* correto = "-";
+            if (desfecho == FILHO_FALHOU) {
+                //Uma configuracao que quebra conta como erro, nao como tempo esgotado
+                correto = "nao";
+                erros++;
+            } else if (e.resultado != SOLVER_DESCONHECIDO) {
+                if (referencia == SOLVER_DESCONHECIDO) referencia = e.resultado;
+                correto = (e.resultado == referencia && e.modelo_valido) ? "sim" : "nao";
+                if (correto[0] == 'n') erros++;
+            }
+
+            char nome_config[64];
+            if (c == CONFIG_CUBOS) snprintf(nome_config, sizeof(nome_config), "cubos-%dt", n_threads);
+            else snprintf(nome_config, sizeof(nome_config), "%s", NOMES_CONFIG[c]);
+
+            fprintf(saida, "%s,%d,%d,%s,%s,%s,%s,%.4f,%ld\n",
+                    suite[i].nome, n_variaveis, n_clausulas, nome_config,
+                    desfecho == FILHO_FALHOU ? "ERRO" :
+                    e.resultado == SOLVER_SAT ? "SAT" : e.resultado == SOLVER_UNSAT ? "UNSAT" : "UNKNOWN",
+                    esperado == ESPERADO_SAT ? "SAT" : esperado == ESPERADO_UNSAT ? "UNSAT" : "?",
+                    correto, e.tempo, memoria_kb);
+            fflush(saida);
+        }
+    }
+
+    if (saida != stdout) fclose(saida);
+    if (erros > 0) {
+        printf("%d execucoes com resultado incorreto!\n", erros);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,340 @@
+#ifndef CUBOS_H
+#define CUBOS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include "formula.h"
+
+/*
+    CUBE-AND-CONQUER
+
+    O espaco de busca e dividido em cubos (atribuicoes parciais sobre as
+    variaveis mais frequentes). Cada cubo e resolvido com o mesmo backtracking
+    de sat(), em paralelo, por um pool de threads com roubo de trabalho:
+    cada thread consome a propria fila pelo fim e, quando ela esvazia, rouba
+    do inicio da fila de outra thread. Um cubo que estoura o orcamento de nos
+    e re-dividido em dois cubos menores e devolvido a fila.
+
+    A busca do cubo re-dividido nao e guardada: os dois filhos recomecam do
+    zero. Para que um cubo dificil nao pague o orcamento inteiro a cada nivel
+    de re-divisao, cada filho recebe o dobro do orcamento do pai; o trabalho
+    perdido fica limitado a uma fracao constante da busca que resolve o cubo,
+    como no aprofundamento iterativo.
+*/
+
+#define ORCAMENTO_CUBO 20000    //Nos de busca de um cubo inicial antes de re-dividi-lo
+#define CUBOS_POR_THREAD 8
+
+typedef enum {
+    BUSCA_UNSAT,
+    BUSCA_SAT,
+    BUSCA_ESGOTADA     //Orcamento estourado ou busca interrompida
+} ResultadoBusca;
+
+
+//Um cubo e uma lista de literais assumidos como verdadeiros
+typedef struct {
+    int* literais;
+    int n_literais;
+    long orcamento;     //Nos de busca antes de re-dividir; dobra a cada re-divisao
+} Cubo;
+
+
+//Fila dupla de cubos de uma thread: o dono usa o fim, os ladroes o inicio
+typedef struct {
+    Cubo* itens;
+    int inicio, fim, capacidade;
+    pthread_mutex_t trava;
+} FilaCubos;
+
+
+typedef struct {
+    Formula* formula;
+    FilaCubos* filas;
+    int n_threads;
+    double* pontuacao;          //Pontuacao de cada variavel para ramificacao
+    atomic_int pendentes;       //Cubos ainda nao resolvidos (na fila ou em execucao)
+    atomic_bool encontrou_sat;
+    pthread_mutex_t trava_resultado;
+    Interpretacao resultado;
+} PoolCubos;
+
+
+typedef struct {
+    PoolCubos* pool;
+    int id;
+} ArgThread;
+
+
+void fila_iniciar(FilaCubos* fila) {
+    fila->capacidade = 64;
+    fila->itens = (Cubo*)malloc(fila->capacidade * sizeof(Cubo));
+    fila->inicio = fila->fim = 0;
+    pthread_mutex_init(&fila->trava, NULL);
+}
+
+void fila_empilhar(FilaCubos* fila, Cubo cubo) {
+    pthread_mutex_lock(&fila->trava);
+    if (fila->fim == fila->capacidade) {
+        int n = fila->fim - fila->inicio;
+        //Reaproveita o espaco liberado pelos roubos antes de crescer
+        if (fila->inicio > 0) {
+            memmove(fila->itens, fila->itens + fila->inicio, n * sizeof(Cubo));
+        }
+        if (n == fila->capacidade) {
+            fila->capacidade *= 2;
+            fila->itens = (Cubo*)realloc(fila->itens, fila->capacidade * sizeof(Cubo));
+        }
+        fila->inicio = 0;
+        fila->fim = n;
+    }
+    fila->itens[fila->fim++] = cubo;
+    pthread_mutex_unlock(&fila->trava);
+}
+
+//Retira do fim (uso pelo dono da fila)
+bool fila_desempilhar(FilaCubos* fila, Cubo* cubo) {
+    bool ok = false;
+    pthread_mutex_lock(&fila->trava);
+    if (fila->fim > fila->inicio) {
+        *cubo = fila->itens[--fila->fim];
+        ok = true;
+    }
+    pthread_mutex_unlock(&fila->trava);
+    return ok;
+}
+
+//Retira do inicio (uso por outra thread)
+bool fila_roubar(FilaCubos* fila, Cubo* cubo) {
+    bool ok = false;
+    pthread_mutex_lock(&fila->trava);
+    if (fila->fim > fila->inicio) {
+        *cubo = fila->itens[fila->inicio++];
+        ok = true;
+    }
+    pthread_mutex_unlock(&fila->trava);
+    return ok;
+}
+
+void fila_liberar(FilaCubos* fila) {
+    for (int i = fila->inicio; i < fila->fim; i++) {
+        free(fila->itens[i].literais);
+    }
+    free(fila->itens);
+    pthread_mutex_destroy(&fila->trava);
+}
+
+
+//Variaveis em clausulas curtas pesam mais (cada literal vale 2^-tamanho)
+double* calcular_pontuacao(const Formula* formula) {
+    double* pontuacao = (double*)calloc(formula->n_variaveis + 1, sizeof(double));
+    for (int i = 0; i < formula->n_clausulas; i++) {
+        const Clausula* c = &formula->clausulas[i];
+        double peso = ldexp(1.0, -c->num_literais);
+        for (int j = 0; j < c->num_literais; j++) {
+            pontuacao[abs(c->literais[j])] += peso;
+        }
+    }
+    return pontuacao;
+}
+
+//Escolhe a variavel livre de maior pontuacao, ou -1 se todas estiverem atribuidas
+int escolher_var_ramificacao(const double* pontuacao, const Interpretacao* interpretacao) {
+    int melhor = -1;
+    for (int i = 1; i <= interpretacao->n_variaveis; i++) {
+        if (interpretacao->valores[i] == -1 &&
+            (melhor == -1 || pontuacao[i] > pontuacao[melhor])) {
+            melhor = i;
+        }
+    }
+    return melhor;
+}
+
+Cubo estender_cubo(const Cubo* cubo, int literal) {
+    Cubo novo;
+    novo.n_literais = cubo->n_literais + 1;
+    novo.literais = (int*)malloc(novo.n_literais * sizeof(int));
+    if (cubo->n_literais > 0) {
+        memcpy(novo.literais, cubo->literais, cubo->n_literais * sizeof(int));
+    }
+    novo.literais[cubo->n_literais] = literal;
+    novo.orcamento = cubo->orcamento < LONG_MAX / 2 ? 2 * cubo->orcamento : cubo->orcamento;
+    return novo;
+}
+
+
+//Mesmo backtracking de sat(), mas limitado por um orcamento de nos e interrompivel
+ResultadoBusca sat_limitado(Formula* formula, Interpretacao* interpretacao,
+                            long* orcamento, atomic_bool* parar) {
+    if (atomic_load_explicit(parar, memory_order_relaxed)) return BUSCA_ESGOTADA;
+    if ((*orcamento)-- <= 0) return BUSCA_ESGOTADA;
+
+    for (int i = 0; i < formula->n_clausulas; i++) {
+        if (!clausula_sat(&formula->clausulas[i], interpretacao)) {
+            if (todas_var_atribuidas(&formula->clausulas[i], interpretacao)) {
+                return BUSCA_UNSAT;
+            }
+        }
+    }
+
+    int var_nao_atribuida = encontrar_var_livre(interpretacao);
+    if (var_nao_atribuida == -1) return BUSCA_SAT;
+
+    for (int valor = 1; valor >= 0; valor--) {
+        interpretacao->valores[var_nao_atribuida] = valor;
+        ResultadoBusca r = sat_limitado(formula, interpretacao, orcamento, parar);
+        if (r != BUSCA_UNSAT) {
+            if (r == BUSCA_ESGOTADA) interpretacao->valores[var_nao_atribuida] = -1;
+            return r;
+        }
+    }
+
+    //Backtracking
+    interpretacao->valores[var_nao_atribuida] = -1;
+    return BUSCA_UNSAT;
+}
+
+
+void aplicar_cubo(Interpretacao* interpretacao, const Cubo* cubo) {
+    for (int i = 1; i <= interpretacao->n_variaveis; i++) {
+        interpretacao->valores[i] = -1;
+    }
+    for (int i = 0; i < cubo->n_literais; i++) {
+        int literal = cubo->literais[i];
+        interpretacao->valores[abs(literal)] = literal > 0 ? 1 : 0;
+    }
+}
+
+//Procura trabalho na propria fila e, se vazia, nas filas das outras threads
+bool obter_cubo(PoolCubos* pool, int id, Cubo* cubo) {
+    if (fila_desempilhar(&pool->filas[id], cubo)) return true;
+    for (int k = 1; k < pool->n_threads; k++) {
+        if (fila_roubar(&pool->filas[(id + k) % pool->n_threads], cubo)) return true;
+    }
+    return false;
+}
+
+void* trabalhador_cubos(void* arg) {
+    PoolCubos* pool = ((ArgThread*)arg)->pool;
+    int id = ((ArgThread*)arg)->id;
+
+    Interpretacao I;
+    I.n_variaveis = pool->formula->n_variaveis;
+    I.valores = (int*)malloc((I.n_variaveis + 1) * sizeof(int));
+
+    while (!atomic_load(&pool->encontrou_sat) && atomic_load(&pool->pendentes) > 0) {
+        Cubo cubo;
+        if (!obter_cubo(pool, id, &cubo)) {
+            sched_yield();
+            continue;
+        }
+
+        aplicar_cubo(&I, &cubo);
+        long orcamento = cubo.orcamento;
+        ResultadoBusca r = sat_limitado(pool->formula, &I, &orcamento, &pool->encontrou_sat);
+
+        if (r == BUSCA_SAT) {
+            pthread_mutex_lock(&pool->trava_resultado);
+            if (!atomic_load(&pool->encontrou_sat)) {
+                memcpy(pool->resultado.valores, I.valores, (I.n_variaveis + 1) * sizeof(int));
+                atomic_store(&pool->encontrou_sat, true);
+            }
+            pthread_mutex_unlock(&pool->trava_resultado);
+        } else if (r == BUSCA_ESGOTADA && !atomic_load(&pool->encontrou_sat)) {
+            //Cubo lento: divide na proxima variavel de ramificacao e devolve a fila, com o dobro do orcamento
+            aplicar_cubo(&I, &cubo);
+            int var = escolher_var_ramificacao(pool->pontuacao, &I);
+            atomic_fetch_add(&pool->pendentes, 2);
+            fila_empilhar(&pool->filas[id], estender_cubo(&cubo, -var));
+            fila_empilhar(&pool->filas[id], estender_cubo(&cubo, var));
+        }
+
+        free(cubo.literais);
+        atomic_fetch_sub(&pool->pendentes, 1);
+    }
+
+    free(I.valores);
+    return NULL;
+}
+
+
+//Gera os cubos iniciais fixando as variaveis de maior pontuacao
+void gerar_cubos(PoolCubos* pool, int n_cubos) {
+    Interpretacao I;
+    I.n_variaveis = pool->formula->n_variaveis;
+    I.valores = (int*)malloc((I.n_variaveis + 1) * sizeof(int));
+    for (int i = 1; i <= I.n_variaveis; i++) I.valores[i] = -1;
+
+    int profundidade = 0;
+    int* vars = (int*)malloc((I.n_variaveis + 1) * sizeof(int));
+    while ((1 << profundidade) < n_cubos && profundidade < 20) {
+        int var = escolher_var_ramificacao(pool->pontuacao, &I);
+        if (var == -1) break;
+        vars[profundidade++] = var;
+        I.valores[var] = 0;
+    }
+
+    //Cada cubo corresponde a um padrao de bits sobre as variaveis escolhidas
+    int total = 1 << profundidade;
+    atomic_store(&pool->pendentes, total);
+    for (int m = 0; m < total; m++) {
+        Cubo cubo;
+        cubo.n_literais = profundidade;
+        cubo.orcamento = ORCAMENTO_CUBO;
+        cubo.literais = (int*)malloc((profundidade + 1) * sizeof(int));
+        for (int d = 0; d < profundidade; d++) {
+            cubo.literais[d] = (m >> d) & 1 ? vars[d] : -vars[d];
+        }
+        fila_empilhar(&pool->filas[m % pool->n_threads], cubo);
+    }
+
+    free(vars);
+    free(I.valores);
+}
+
+//Resolve a formula pelo metodo cube-and-conquer; em caso de SAT preenche interpretacao
+bool sat_cubos(Formula* formula, Interpretacao* interpretacao, int n_threads) {
+    if (n_threads < 1) n_threads = 1;
+
+    PoolCubos pool;
+    pool.formula = formula;
+    pool.n_threads = n_threads;
+    pool.pontuacao = calcular_pontuacao(formula);
+    pool.filas = (FilaCubos*)malloc(n_threads * sizeof(FilaCubos));
+    for (int i = 0; i < n_threads; i++) fila_iniciar(&pool.filas[i]);
+    atomic_init(&pool.pendentes, 0);
+    atomic_init(&pool.encontrou_sat, false);
+    pthread_mutex_init(&pool.trava_resultado, NULL);
+    pool.resultado = *interpretacao;
+
+    gerar_cubos(&pool, n_threads * CUBOS_POR_THREAD);
+
+    pthread_t* threads = (pthread_t*)malloc(n_threads * sizeof(pthread_t));
+    ArgThread* args = (ArgThread*)malloc(n_threads * sizeof(ArgThread));
+    for (int i = 0; i < n_threads; i++) {
+        args[i].pool = &pool;
+        args[i].id = i;
+        pthread_create(&threads[i], NULL, trabalhador_cubos, &args[i]);
+    }
+    for (int i = 0; i < n_threads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    bool resultado = atomic_load(&pool.encontrou_sat);
+
+    for (int i = 0; i < n_threads; i++) fila_liberar(&pool.filas[i]);
+    pthread_mutex_destroy(&pool.trava_resultado);
+    free(pool.filas);
+    free(pool.pontuacao);
+    free(threads);
+    free(args);
+    return resultado;
+}
+
+#endif
@@ -0,0 +1,285 @@
+#ifndef FORMULA_H
+#define FORMULA_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+//Representa uma cláusula como uma lista de literais
+typedef struct {
+    int* literais;
+    int num_literais;
+} Clausula;
+
+
+//Uma formula cnf eh composta de cláusulas, e cada cláusula eh composta por literais
+typedef struct {
+    Clausula* clausulas;     
+    int n_clausulas;     
+    int n_variaveis;      
+} Formula;
+
+
+//A interpretacao parcial atribui valores as clausulas
+typedef struct {
+    int* valores;     
+    int n_variaveis;       
+} Interpretacao;
+
+
+#ifdef _WIN32
+#define popen _popen
+#define pclose _pclose
+#else
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
+
+static bool termina_com(const char* texto, const char* sufixo) {
+    size_t n = strlen(texto), m = strlen(sufixo);
+    return n >= m && strcmp(texto + n - m, sufixo) == 0;
+}
+
+/*
+    Abre o arquivo de entrada; .gz, .xz e .bz2 sao descompactados em fluxo
+    por um processo externo. O caminho vai direto como argumento do
+    descompactador, sem passar por um shell, entao aspas, $ ou crases no
+    nome nao sao interpretados. *processo recebe o pid do descompactador
+    (0 se o arquivo foi aberto diretamente); feche com fechar_entrada().
+*/
+FILE* abrir_entrada(const char* nome_arquivo, long* processo) {
+    const char* descompactador = NULL;
+    if (termina_com(nome_arquivo, ".gz")) descompactador = "gzip";
+    else if (termina_com(nome_arquivo, ".xz")) descompactador = "xz";
+    else if (termina_com(nome_arquivo, ".bz2")) descompactador = "bzip2";
+
+    *processo = 0;
+    if (descompactador == NULL) return fopen(nome_arquivo, "r");
+
+#ifdef _WIN32
+    //Sem fork no Windows: o caminho vai entre aspas, que nao podem aparecer em nomes de arquivo
+    char comando[4096];
+    int tamanho = snprintf(comando, sizeof(comando), "%s -dc \"%s\"", descompactador, nome_arquivo);
+    if (tamanho < 0 || tamanho >= (int)sizeof(comando) || strchr(nome_arquivo, '"') != NULL) return NULL;
+    *processo = -1;
+    return popen(comando, "r");
+#else
+    int canal[2];
+    if (pipe(canal) != 0) return NULL;
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(canal[0]);
+        close(canal[1]);
+        return NULL;
+    }
+    if (pid == 0) {
+        dup2(canal[1], STDOUT_FILENO);
+        close(canal[0]);
+        close(canal[1]);
+        execlp(descompactador, descompactador, "-dc", "--", nome_arquivo, (char*)NULL);
+        _exit(127);     //Descompactador nao encontrado
+    }
+    close(canal[1]);
+    *processo = (long)pid;
+    return fdopen(canal[0], "r");
+#endif
+}
+
+//Fecha o arquivo de abrir_entrada(); false se o descompactador terminou com erro (arquivo corrompido)
+bool fechar_entrada(FILE* arquivo, long processo) {
+    if (processo == 0) return fclose(arquivo) == 0;
+#ifdef _WIN32
+    return pclose(arquivo) == 0;
+#else
+    //Esvazia o canal, para o descompactador nao ficar bloqueado escrevendo
+    while (getc(arquivo) != EOF);
+    fclose(arquivo);
+    int status;
+    if (waitpid((pid_t)processo, &status, 0) < 0) return false;
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+#endif
+}
+
+//Le o proximo inteiro do fluxo, pulando espacos e linhas de comentario; false no fim da formula
+static bool ler_inteiro(FILE* arquivo, int* valor) {
+    int c = getc(arquivo);
+    for (;;) {
+        while (c == ' ' || c == '\t' || c == '\n' || c == '\r') c = getc(arquivo);
+        if (c != 'c') break;
+        while (c != '\n' && c != EOF) c = getc(arquivo);
+    }
+    if (c == EOF || c == '%') return false;   //'%' encerra a formula nos arquivos SATLIB
+
+    int sinal = 1;
+    if (c == '-') {
+        sinal = -1;
+        c = getc(arquivo);
+    }
+    if (c < '0' || c > '9') {
+        printf("Caractere inesperado '%c' na formula.\n", c);
+        exit(1);
+    }
+    int n = 0;
+    while (c >= '0' && c <= '9') {
+        n = n * 10 + (c - '0');
+        c = getc(arquivo);
+    }
+    *valor = sinal * n;
+    return true;
+}
+
+//Função para ler a fórmula CNF do arquivo (clausulas podem ocupar varias linhas)
+Formula ler_formula(const char* nome_arquivo) {
+    Formula F;
+    char texto[1000];
+    long processo;
+    FILE* arquivo_entrada = abrir_entrada(nome_arquivo, &processo);
+    if (arquivo_entrada == NULL) {
+        printf("Erro ao abrir o arquivo %s.\n", nome_arquivo);
+        exit(1);
+    }
+
+    F.n_variaveis = F.n_clausulas = -1;
+    while (fgets(texto, sizeof(texto), arquivo_entrada)) {
+        if (texto[0] == 'c') {
+            //Comentarios longos podem nao caber no buffer
+            while (strchr(texto, '\n') == NULL && fgets(texto, sizeof(texto), arquivo_entrada));
+            continue;
+        }
+        if (texto[0] == 'p') {
+            sscanf(texto, "p cnf %d %d", &F.n_variaveis, &F.n_clausulas);
+            break;
+        }
+    }
+    if (F.n_variaveis < 0 || F.n_clausulas < 0) {
+        if (!fechar_entrada(arquivo_entrada, processo)) {
+            printf("Erro ao ler o arquivo %s.\n", nome_arquivo);
+            exit(1);
+        }
+        printf("Cabecalho 'p cnf' nao encontrado em %s.\n", nome_arquivo);
+        exit(1);
+    }
+
+    int capacidade = F.n_clausulas > 0 ? F.n_clausulas : 1;
+    F.clausulas = (Clausula*)malloc(capacidade * sizeof(Clausula));
+
+    int capacidade_aux = 64;
+    int* literais_aux = (int*)malloc(capacidade_aux * sizeof(int));
+    int lits_lidos = 0;
+    int clausula_idx = 0;
+    int literal_atual;
+
+    bool fim = false;
+    while (!fim) {
+        //Uma clausula sem o 0 final no fim do arquivo tambem e aceita
+        fim = !ler_inteiro(arquivo_entrada, &literal_atual);
+        if (fim) {
+            if (lits_lidos == 0) break;
+            literal_atual = 0;
+        }
+
+        if (literal_atual != 0) {
+            if (lits_lidos == capacidade_aux) {
+                capacidade_aux *= 2;
+                literais_aux = (int*)realloc(literais_aux, capacidade_aux * sizeof(int));
+            }
+            literais_aux[lits_lidos++] = literal_atual;
+            //Garante que valores[] cubra variaveis acima do declarado no cabecalho
+            if (abs(literal_atual) > F.n_variaveis) F.n_variaveis = abs(literal_atual);
+            continue;
+        }
+
+        if (clausula_idx == capacidade) {
+            capacidade *= 2;
+            F.clausulas = (Clausula*)realloc(F.clausulas, capacidade * sizeof(Clausula));
+        }
+        F.clausulas[clausula_idx].num_literais = lits_lidos;
+        F.clausulas[clausula_idx].literais = (int*)malloc((lits_lidos > 0 ? lits_lidos : 1) * sizeof(int));
+        memcpy(F.clausulas[clausula_idx].literais, literais_aux, lits_lidos * sizeof(int));
+        clausula_idx++;
+        lits_lidos = 0;
+    }
+    F.n_clausulas = clausula_idx;
+
+    free(literais_aux);
+    //Um arquivo compactado corrompido chega ate aqui com a formula truncada
+    if (!fechar_entrada(arquivo_entrada, processo)) {
+        printf("Erro ao ler o arquivo %s.\n", nome_arquivo);
+        exit(1);
+    }
+    return F;
+}
+
+void liberar_formula(Formula* formula) {
+    for (int i = 0; i < formula->n_clausulas; i++) {
+        free(formula->clausulas[i].literais);
+    }
+    free(formula->clausulas);
+}
+
+//Função para verificar se uma cláusula é satisfeita pela interpretação atual
+bool clausula_sat(const Clausula* clausula, const Interpretacao* interpretacao) {
+    for (int i = 0; i < clausula->num_literais; i++) {
+        int literal = clausula->literais[i];
+        int variavel_idx = abs(literal);
+        int valor = interpretacao->valores[variavel_idx];
+        if ((literal > 0 && valor == 1) || (literal < 0 && valor == 0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//Função para verificar se todas as variáveis em uma cláusula foram atribuídas
+bool todas_var_atribuidas(const Clausula* clausula, const Interpretacao* interpretacao) {
+    for (int i = 0; i < clausula->num_literais; i++) {
+        int variavel_idx = abs(clausula->literais[i]);
+        if (interpretacao->valores[variavel_idx] == -1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//Função para encontrar a primeira variável livre (não atribuída)
+int encontrar_var_livre(const Interpretacao* interpretacao) {
+    for (int i = 1; i <= interpretacao->n_variaveis; i++) {
+        if (interpretacao->valores[i] == -1) {
+            return i;
+        }
+    }
+    return -1; //Retorna -1 se todas as variáveis estiverem atribuídas
+}
+
+//Função principal para determinar se a fórmula F é satisfatível
+bool sat(Formula* formula, Interpretacao* interpretacao) {
+    for (int i = 0; i < formula->n_clausulas; i++) {
+        if (!clausula_sat(&formula->clausulas[i], interpretacao)) {
+            if (todas_var_atribuidas(&formula->clausulas[i], interpretacao)) {
+                return false;
+            }
+        }
+    }
+
+    if (encontrar_var_livre(interpretacao) == -1) {
+        return true; //Todas as cláusulas foram satisfeitas com a atribuição atual
+    }
+
+    int var_nao_atribuida = encontrar_var_livre(interpretacao);
+
+    //Tenta atribuir TRUE
+    interpretacao->valores[var_nao_atribuida] = 1;
+    if (sat(formula, interpretacao)) return true;
+
+    //Tenta atribuir FALSE
+    interpretacao->valores[var_nao_atribuida] = 0;
+    if (sat(formula, interpretacao)) return true;
+
+    //Backtracking
+    interpretacao->valores[var_nao_atribuida] = -1;
+    return false;
+}
+
+#endif
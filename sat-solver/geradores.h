@@ -0,0 +1,243 @@
+#ifndef GERADORES_H
+#define GERADORES_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "formula.h"
+
+/*
+    GERADORES DE INSTANCIAS
+
+    Familias classicas para o benchmark, geradas de forma reprodutivel a
+    partir de uma semente:
+      - k-SAT aleatorio (na transicao de fase, resultado desconhecido)
+      - principio da casa dos pombos: n+1 pombos em n casas (sempre UNSAT)
+      - paridade: duas cadeias de XOR sobre as mesmas variaveis em ordens
+        diferentes, com paridades iguais (SAT) ou opostas (UNSAT)
+      - coloracao de grafos com uma k-coloracao plantada (sempre SAT)
+*/
+
+typedef enum {
+    GERADOR_KSAT,
+    GERADOR_POMBOS,
+    GERADOR_PARIDADE,
+    GERADOR_COLORACAO
+} TipoGerador;
+
+typedef enum {
+    ESPERADO_DESCONHECIDO,
+    ESPERADO_SAT,
+    ESPERADO_UNSAT
+} Esperado;
+
+
+//Parametros de uma instancia; o significado de a e b depende do gerador
+typedef struct {
+    TipoGerador tipo;
+    int a, b;               //ksat: k, n | pombos: casas | paridade: n, satisfativel | coloracao: vertices, cores
+    double razao;           //ksat: clausulas/variavel | coloracao: arestas/vertice
+    unsigned int semente;
+    char nome[64];
+} Instancia;
+
+
+//Formula com capacidade conhecida, preenchida clausula a clausula
+typedef struct {
+    Formula F;
+    int capacidade;
+} Construtor;
+
+
+//xorshift64*: independe do rand() da plataforma, entao as instancias sao iguais em qualquer sistema
+static unsigned int aleatorio(unsigned long long* estado) {
+    *estado ^= *estado >> 12;
+    *estado ^= *estado << 25;
+    *estado ^= *estado >> 27;
+    return (unsigned int)((*estado * 2685821657736338717ULL) >> 32);
+}
+
+void construtor_iniciar(Construtor* c, int n_variaveis, int capacidade) {
+    c->F.n_variaveis = n_variaveis;
+    c->F.n_clausulas = 0;
+    c->capacidade = capacidade > 0 ? capacidade : 1;
+    c->F.clausulas = (Clausula*)malloc(c->capacidade * sizeof(Clausula));
+}
+
+void construtor_clausula(Construtor* c, const int* lits, int n) {
+    if (c->F.n_clausulas == c->capacidade) {
+        c->capacidade *= 2;
+        c->F.clausulas = (Clausula*)realloc(c->F.clausulas, c->capacidade * sizeof(Clausula));
+    }
+    Clausula* cl = &c->F.clausulas[c->F.n_clausulas++];
+    cl->num_literais = n;
+    cl->literais = (int*)malloc(n * sizeof(int));
+    memcpy(cl->literais, lits, n * sizeof(int));
+}
+
+
+//k-SAT aleatorio com n variaveis e razao*n clausulas de k variaveis distintas
+Formula gerar_ksat(int k, int n, double razao, unsigned int semente) {
+    unsigned long long estado = 0x9E3779B97F4A7C15ULL ^ semente;
+    int m = (int)(razao * n + 0.5);
+    Construtor c;
+    construtor_iniciar(&c, n, m);
+
+    int* lits = (int*)malloc(k * sizeof(int));
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < k; j++) {
+            int var;
+            bool repetida;
+            do {
+                var = (int)(aleatorio(&estado) % n) + 1;
+                repetida = false;
+                for (int t = 0; t < j; t++) repetida |= abs(lits[t]) == var;
+            } while (repetida);
+            lits[j] = (aleatorio(&estado) & 1) ? var : -var;
+        }
+        construtor_clausula(&c, lits, k);
+    }
+    free(lits);
+    return c.F;
+}
+
+//n+1 pombos em n casas; variavel p*n + h + 1 indica o pombo p na casa h
+Formula gerar_pombos(int n) {
+    int pombos = n + 1;
+    Construtor c;
+    construtor_iniciar(&c, pombos * n, pombos + n * pombos * n / 2);
+
+    int* lits = (int*)malloc(n * sizeof(int));
+    for (int p = 0; p < pombos; p++) {
+        for (int h = 0; h < n; h++) lits[h] = p * n + h + 1;
+        construtor_clausula(&c, lits, n);
+    }
+    for (int h = 0; h < n; h++) {
+        for (int p = 0; p < pombos; p++) {
+            for (int q = p + 1; q < pombos; q++) {
+                int par[2] = {-(p * n + h + 1), -(q * n + h + 1)};
+                construtor_clausula(&c, par, 2);
+            }
+        }
+    }
+    free(lits);
+    return c.F;
+}
+
+//Clausulas de z = a XOR b
+static void clausulas_xor(Construtor* c, int z, int a, int b) {
+    int c1[3] = {-z, a, b};
+    int c2[3] = {-z, -a, -b};
+    int c3[3] = {z, -a, b};
+    int c4[3] = {z, a, -b};
+    construtor_clausula(c, c1, 3);
+    construtor_clausula(c, c2, 3);
+    construtor_clausula(c, c3, 3);
+    construtor_clausula(c, c4, 3);
+}
+
+//Codifica x[ordem[0]] XOR ... XOR x[ordem[n-1]] = paridade usando variaveis auxiliares a partir de prox_var
+static int cadeia_xor(Construtor* c, const int* ordem, int n, int paridade, int prox_var) {
+    int acumulado = ordem[0];
+    for (int i = 1; i < n; i++) {
+        int z = prox_var++;
+        clausulas_xor(c, z, acumulado, ordem[i]);
+        acumulado = z;
+    }
+    int unidade = paridade ? acumulado : -acumulado;
+    construtor_clausula(c, &unidade, 1);
+    return prox_var;
+}
+
+//Duas cadeias de paridade sobre x1..xn; SAT se ambas exigem a mesma paridade
+Formula gerar_paridade(int n, bool satisfativel, unsigned int semente) {
+    unsigned long long estado = 0x9E3779B97F4A7C15ULL ^ semente;
+    Construtor c;
+    construtor_iniciar(&c, n + 2 * (n - 1), 8 * n + 2);
+
+    int* ordem = (int*)malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) ordem[i] = i + 1;
+    //Paridade 1 na primeira cadeia para que a atribuicao toda falsa nao seja solucao trivial
+    int prox_var = cadeia_xor(&c, ordem, n, 1, n + 1);
+
+    //Segunda cadeia em ordem embaralhada (Fisher-Yates)
+    for (int i = n - 1; i > 0; i--) {
+        int j = (int)(aleatorio(&estado) % (i + 1));
+        int tmp = ordem[i];
+        ordem[i] = ordem[j];
+        ordem[j] = tmp;
+    }
+    cadeia_xor(&c, ordem, n, satisfativel ? 1 : 0, prox_var);
+
+    free(ordem);
+    return c.F;
+}
+
+//k-coloracao de um grafo aleatorio com coloracao plantada; variavel v*k + cor + 1
+Formula gerar_coloracao(int vertices, int k, double razao_arestas, unsigned int semente) {
+    unsigned long long estado = 0x9E3779B97F4A7C15ULL ^ semente;
+    int arestas = (int)(razao_arestas * vertices + 0.5);
+    Construtor c;
+    construtor_iniciar(&c, vertices * k, vertices * (1 + k * (k - 1) / 2) + arestas * k);
+
+    int* cor = (int*)malloc(vertices * sizeof(int));
+    for (int v = 0; v < vertices; v++) cor[v] = (int)(aleatorio(&estado) % k);
+
+    int* lits = (int*)malloc(k * sizeof(int));
+    for (int v = 0; v < vertices; v++) {
+        for (int i = 0; i < k; i++) lits[i] = v * k + i + 1;
+        construtor_clausula(&c, lits, k);
+        for (int i = 0; i < k; i++) {
+            for (int j = i + 1; j < k; j++) {
+                int par[2] = {-(v * k + i + 1), -(v * k + j + 1)};
+                construtor_clausula(&c, par, 2);
+            }
+        }
+    }
+
+    //Arestas apenas entre vertices de cores plantadas diferentes
+    for (int e = 0; k > 1 && e < arestas; e++) {
+        int u, w;
+        do {
+            u = (int)(aleatorio(&estado) % vertices);
+            w = (int)(aleatorio(&estado) % vertices);
+        } while (cor[u] == cor[w]);
+        for (int i = 0; i < k; i++) {
+            int par[2] = {-(u * k + i + 1), -(w * k + i + 1)};
+            construtor_clausula(&c, par, 2);
+        }
+    }
+
+    free(cor);
+    free(lits);
+    return c.F;
+}
+
+Formula gerar_instancia(const Instancia* inst, Esperado* esperado) {
+    switch (inst->tipo) {
+        case GERADOR_KSAT:
+            *esperado = ESPERADO_DESCONHECIDO;
+            return gerar_ksat(inst->a, inst->b, inst->razao, inst->semente);
+        case GERADOR_POMBOS:
+            *esperado = ESPERADO_UNSAT;
+            return gerar_pombos(inst->a);
+        case GERADOR_PARIDADE:
+            *esperado = inst->b ? ESPERADO_SAT : ESPERADO_UNSAT;
+            return gerar_paridade(inst->a, inst->b, inst->semente);
+        default:
+            *esperado = ESPERADO_SAT;
+            return gerar_coloracao(inst->a, inst->b, inst->razao, inst->semente);
+    }
+}
+
+void escrever_formula(const Formula* formula, FILE* saida) {
+    fprintf(saida, "p cnf %d %d\n", formula->n_variaveis, formula->n_clausulas);
+    for (int i = 0; i < formula->n_clausulas; i++) {
+        for (int j = 0; j < formula->clausulas[i].num_literais; j++) {
+            fprintf(saida, "%d ", formula->clausulas[i].literais[j]);
+        }
+        fprintf(saida, "0\n");
+    }
+}
+
+#endif
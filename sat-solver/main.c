@@ -1,144 +1,85 @@
 #include <stdio.h>
 #include <stdbool.h>
-#include <math.h>
 #include <stdlib.h>
-
-//Representa uma cláusula como uma lista de literais
-typedef struct {
-    int* literais;
-    int num_literais;
-} Clausula;
-
-
-//Uma formula cnf eh composta de cláusulas, e cada cláusula eh composta por literais
-typedef struct {
-    Clausula* clausulas;     
-    int n_clausulas;     
-    int n_variaveis;      
-} Formula;
-
-
-//A interpretacao parcial atribui valores as clausulas
-typedef struct {
-    int* valores;     
-    int n_variaveis;       
-} Interpretacao;
-
-
-//Função para ler a fórmula CNF do arquivo
-Formula ler_formula(const char* nome_arquivo) {
-    Formula F;
-    char texto[1000];
-    FILE* arquivo_entrada = fopen(nome_arquivo, "r");
-    if (arquivo_entrada == NULL) {
-        printf("Erro ao abrir o arquivo %s.\n", nome_arquivo);
-        exit(1);
-    }
-
-    while (fgets(texto, sizeof(texto), arquivo_entrada)) {
-        if (texto[0] == 'c') continue;
-        if (texto[0] == 'p') {
-            sscanf(texto, "p cnf %d %d", &F.n_variaveis, &F.n_clausulas);
-            F.clausulas = (Clausula*)malloc(F.n_clausulas * sizeof(Clausula));
-            break;
-        }
-    }
-
-    int clausula_idx = 0;
-
-    while (fgets(texto, sizeof(texto), arquivo_entrada)) {
-        if (texto[0] == 'c' || texto[0] == 'p') continue;
-
-        int literais_aux[200];
-        int lits_lidos = 0;
-        char* ptr = texto;
-
-        while (*ptr != '\0') {
-            int literal_atual;
-            sscanf(ptr, "%d", &literal_atual);
-            if (literal_atual == 0) break;
-            literais_aux[lits_lidos++] = literal_atual;
-            while (*ptr != ' ' && *ptr != '\n' && *ptr != '\0') ptr++;
-            while (*ptr == ' ') ptr++;
-        }
-
-        F.clausulas[clausula_idx].num_literais = lits_lidos;
-        F.clausulas[clausula_idx].literais = (int*)malloc(lits_lidos * sizeof(int));
-        for (int i = 0; i < lits_lidos; i++) {
-            F.clausulas[clausula_idx].literais[i] = literais_aux[i];
-        }
-        clausula_idx++;
-    }
-
-    fclose(arquivo_entrada);
-    return F;
+#include <string.h>
+#include <limits.h>
+#include <signal.h>
+#include <unistd.h>
+#include "formula.h"
+#include "cubos.h"
+#include "solver.h"
+
+//Solver em execucao, para que o SIGINT possa interromper a busca e imprimir as estatisticas
+static Solver* solver_ativo = NULL;
+
+void tratar_sigint(int sinal) {
+    (void)sinal;
+    if (solver_ativo != NULL) solver_interromper(solver_ativo);
+    signal(SIGINT, SIG_DFL);    //Um segundo Ctrl+C encerra imediatamente
 }
 
-//Função para verificar se uma cláusula é satisfeita pela interpretação atual
-bool clausula_sat(const Clausula* clausula, const Interpretacao* interpretacao) {
-    for (int i = 0; i < clausula->num_literais; i++) {
-        int literal = clausula->literais[i];
-        int variavel_idx = abs(literal);
-        int valor = interpretacao->valores[variavel_idx];
-        if ((literal > 0 && valor == 1) || (literal < 0 && valor == 0)) {
-            return true;
-        }
-    }
-    return false;
-}
-
-//Função para verificar se todas as variáveis em uma cláusula foram atribuídas
-bool todas_var_atribuidas(const Clausula* clausula, const Interpretacao* interpretacao) {
-    for (int i = 0; i < clausula->num_literais; i++) {
-        int variavel_idx = abs(clausula->literais[i]);
-        if (interpretacao->valores[variavel_idx] == -1) {
-            return false;
-        }
-    }
-    return true;
-}
-
-//Função para encontrar a primeira variável livre (não atribuída)
-int encontrar_var_livre(const Interpretacao* interpretacao) {
-    for (int i = 1; i <= interpretacao->n_variaveis; i++) {
-        if (interpretacao->valores[i] == -1) {
-            return i;
-        }
-    }
-    return -1; //Retorna -1 se todas as variáveis estiverem atribuídas
-}
-
-//Função principal para determinar se a fórmula F é satisfatível
-bool sat(Formula* formula, Interpretacao* interpretacao) {
-    for (int i = 0; i < formula->n_clausulas; i++) {
-        if (!clausula_sat(&formula->clausulas[i], interpretacao)) {
-            if (todas_var_atribuidas(&formula->clausulas[i], interpretacao)) {
-                return false;
+/*
+    Uso: main [opcoes] [arquivo.cnf]
+        arquivo.cnf         formula DIMACS, opcionalmente .gz, .xz ou .bz2
+                            (padrao: arquivo_entrada.cnf)
+        --dpll              backtracking sequencial original
+        --cubos [n]         cube-and-conquer com n threads
+        --tempo S           limite de tempo em segundos (CDCL)
+        --conflitos N       limite de conflitos (CDCL)
+        --progresso S       intervalo entre linhas de progresso; 0 desativa (CDCL)
+        --prova ARQ         grava a prova DRAT binaria de um UNSAT em ARQ (CDCL)
+    As opcoes marcadas (CDCL) sao recusadas junto com --dpll ou --cubos.
+*/
+int main(int argc, char* argv[]) {
+    bool modo_cubos = false, modo_dpll = false;
+    int n_threads = 4;
+    double limite_tempo = 0, intervalo_progresso = 5.0;
+    long limite_conflitos = -1;
+    const char* arquivo_prova = NULL;
+    const char* arquivo_formula = "arquivo_entrada.cnf";
+    const char* opcao_cdcl = NULL;      //Ultima opcao dada que so vale no modo CDCL
+#ifdef _SC_NPROCESSORS_ONLN
+    n_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--cubos") == 0) {
+            modo_cubos = true;
+            //O numero de threads e opcional: um caminho como "instancia.cnf" fica para a formula
+            if (i + 1 < argc) {
+                char* fim;
+                long n = strtol(argv[i + 1], &fim, 10);
+                if (fim != argv[i + 1] && *fim == '\0' && n >= 1 && n <= INT_MAX) {
+                    n_threads = (int)n;
+                    i++;
+                }
             }
+        } else if (strcmp(argv[i], "--dpll") == 0) {
+            modo_dpll = true;
+        } else if (strcmp(argv[i], "--tempo") == 0 && i + 1 < argc) {
+            opcao_cdcl = argv[i];
+            limite_tempo = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--conflitos") == 0 && i + 1 < argc) {
+            opcao_cdcl = argv[i];
+            limite_conflitos = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--progresso") == 0 && i + 1 < argc) {
+            opcao_cdcl = argv[i];
+            intervalo_progresso = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--prova") == 0 && i + 1 < argc) {
+            opcao_cdcl = argv[i];
+            arquivo_prova = argv[++i];
+        } else if (argv[i][0] != '-') {
+            arquivo_formula = argv[i];
+        } else {
+            printf("Opcao invalida: %s\n", argv[i]);
+            return 1;
         }
     }
-
-    if (encontrar_var_livre(interpretacao) == -1) {
-        return true; //Todas as cláusulas foram satisfeitas com a atribuição atual
+    if ((modo_cubos || modo_dpll) && opcao_cdcl != NULL) {
+        printf("Opcao invalida com %s: %s (so no modo CDCL)\n", modo_cubos ? "--cubos" : "--dpll", opcao_cdcl);
+        return 1;
     }
 
-    int var_nao_atribuida = encontrar_var_livre(interpretacao);
-
-    //Tenta atribuir TRUE
-    interpretacao->valores[var_nao_atribuida] = 1;
-    if (sat(formula, interpretacao)) return true;
-
-    //Tenta atribuir FALSE
-    interpretacao->valores[var_nao_atribuida] = 0;
-    if (sat(formula, interpretacao)) return true;
-
-    //Backtracking
-    interpretacao->valores[var_nao_atribuida] = -1;
-    return false;
-}
-
-int main() {
-    Formula F = ler_formula("arquivo_entrada.cnf");
+    Formula F = ler_formula(arquivo_formula);
 
     Interpretacao I;
     I.n_variaveis = F.n_variaveis;
@@ -147,21 +88,58 @@ int main() {
         I.valores[i] = -1;
     }
 
-    if (sat(&F, &I)) {
+    ResultadoSolver resultado;
+    if (modo_cubos) {
+        resultado = sat_cubos(&F, &I, n_threads) ? SOLVER_SAT : SOLVER_UNSAT;
+    } else if (modo_dpll) {
+        resultado = sat(&F, &I) ? SOLVER_SAT : SOLVER_UNSAT;
+    } else {
+        Solver* s = solver_criar();
+        s->limite_tempo = limite_tempo;
+        s->limite_conflitos = limite_conflitos;
+        s->intervalo_progresso = intervalo_progresso;
+        s->saida_progresso = intervalo_progresso > 0 ? stderr : NULL;
+        if (arquivo_prova != NULL) {
+            s->prova = prova_abrir(arquivo_prova);
+            if (s->prova == NULL) {
+                printf("Erro ao criar o arquivo de prova %s.\n", arquivo_prova);
+                exit(1);
+            }
+        }
+
+        solver_ativo = s;
+        signal(SIGINT, tratar_sigint);
+        resultado = solver_adicionar_formula(s, &F) ? solver_resolver(s, NULL, 0) : SOLVER_UNSAT;
+        signal(SIGINT, SIG_DFL);
+        solver_ativo = NULL;
+
+        for (int i = 1; i <= I.n_variaveis; i++) {
+            I.valores[i] = solver_valor(s, i);
+        }
+        fprintf(stderr, "c resultado=%s\n", resultado == SOLVER_SAT ? "SAT" :
+                resultado == SOLVER_UNSAT ? "UNSAT" : "UNKNOWN");
+        solver_imprimir_estatisticas(s, stderr, "estatisticas");
+        if (s->prova != NULL && !prova_fechar(s->prova)) {
+            printf("Erro ao gravar o arquivo de prova %s.\n", arquivo_prova);
+            exit(1);
+        }
+        solver_liberar(s);
+    }
+
+    if (resultado == SOLVER_SAT) {
         printf("\nFormula e SAT!\n");
         printf("\nInterpretacao final:\n");
         for (int i = 1; i <= I.n_variaveis; i++) {
             printf("x%d = %s\n", i, I.valores[i] == 1 ? "1" : "0");
         }
-    } else {
+    } else if (resultado == SOLVER_UNSAT) {
         printf("\nFormula e UNSAT!\n");
+    } else {
+        printf("\nResultado desconhecido: limite atingido ou busca interrompida.\n");
     }
 
 
-    for (int i = 0; i < F.n_clausulas; i++) {
-        free(F.clausulas[i].literais);
-    }
-    free(F.clausulas);
+    liberar_formula(&F);
     free(I.valores);
 
     return 0;
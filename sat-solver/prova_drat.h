@@ -0,0 +1,79 @@
+#ifndef PROVA_DRAT_H
+#define PROVA_DRAT_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+    PROVA DRAT (FORMATO BINARIO)
+
+    Cada passo da prova e um byte 'a' (clausula adicionada) ou 'd' (clausula
+    removida), seguido dos literais e de um 0. Um literal x e escrito como o
+    inteiro sem sinal 2*|x| + (x < 0), em base 128 com bit de continuacao
+    (o mesmo mapeamento da codificacao interna do solver).
+
+    As escritas passam por um buffer proprio, descarregado com um unico
+    fwrite quando enche, para manter o custo da prova baixo. Uma falha de
+    escrita (disco cheio, erro de E/S) fica marcada em erro e e relatada por
+    prova_fechar(): uma prova truncada nao certifica nada.
+*/
+
+#define TAM_BUFFER_PROVA (1 << 16)
+
+typedef struct {
+    FILE* arquivo;
+    unsigned char buffer[TAM_BUFFER_PROVA];
+    int usado;
+    long passos;
+    int erro;                       //1 se alguma escrita falhou
+} ProvaDRAT;
+
+
+ProvaDRAT* prova_abrir(const char* nome_arquivo) {
+    FILE* arquivo = fopen(nome_arquivo, "wb");
+    if (arquivo == NULL) return NULL;
+    ProvaDRAT* prova = (ProvaDRAT*)malloc(sizeof(ProvaDRAT));
+    prova->arquivo = arquivo;
+    prova->usado = 0;
+    prova->passos = 0;
+    prova->erro = 0;
+    return prova;
+}
+
+void prova_descarregar(ProvaDRAT* prova) {
+    if (prova->usado > 0) {
+        if (fwrite(prova->buffer, 1, prova->usado, prova->arquivo) != (size_t)prova->usado) prova->erro = 1;
+        prova->usado = 0;
+    }
+}
+
+static inline void prova_byte(ProvaDRAT* prova, unsigned char b) {
+    if (prova->usado == TAM_BUFFER_PROVA) prova_descarregar(prova);
+    prova->buffer[prova->usado++] = b;
+}
+
+//Recebe literais na codificacao interna (2*x ou 2*x+1)
+void prova_clausula(ProvaDRAT* prova, char tipo, const int* lits, int n) {
+    prova_byte(prova, (unsigned char)tipo);
+    for (int i = 0; i < n; i++) {
+        unsigned int u = (unsigned int)lits[i];
+        while (u > 127) {
+            prova_byte(prova, (unsigned char)(128 | (u & 127)));
+            u >>= 7;
+        }
+        prova_byte(prova, (unsigned char)u);
+    }
+    prova_byte(prova, 0);
+    prova->passos++;
+}
+
+//Retorna 0 se a prova nao foi gravada por inteiro
+int prova_fechar(ProvaDRAT* prova) {
+    prova_descarregar(prova);
+    int ok = !prova->erro && fflush(prova->arquivo) == 0 && !ferror(prova->arquivo);
+    if (fclose(prova->arquivo) != 0) ok = 0;
+    free(prova);
+    return ok;
+}
+
+#endif
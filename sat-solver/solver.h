@@ -0,0 +1,863 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <limits.h>
+#include <signal.h>
+#include <time.h>
+#include "formula.h"
+#include "prova_drat.h"
+
+/*
+    SOLVER INCREMENTAL (CDCL)
+
+    Interface de biblioteca para chamar o solver muitas vezes sobre a mesma
+    formula base: clausulas podem ser adicionadas entre chamadas e cada
+    chamada resolve sob uma lista de suposicoes (literais assumidos como
+    verdadeiros). Clausulas aprendidas, atividades das variaveis e fases
+    salvas sao mantidas de uma chamada para a outra.
+
+    Uso tipico:
+        Solver* s = solver_criar();
+        solver_adicionar_formula(s, &F);
+        int sup[] = {3, -7};
+        if (solver_resolver(s, sup, 2) == SOLVER_UNSAT) {
+            int n;
+            const int* nucleo = solver_nucleo(s, &n);  //subconjunto de sup
+        }
+        solver_liberar(s);
+
+    Literais seguem o formato DIMACS (x ou -x). Internamente um literal e
+    codificado como 2*x (positivo) ou 2*x+1 (negado).
+
+    Limites de conflitos e de tempo valem por chamada; quando estourados (ou
+    apos solver_interromper()) a chamada retorna SOLVER_DESCONHECIDO.
+
+    Com s->prova apontando para uma ProvaDRAT aberta, as clausulas aprendidas
+    e removidas sao registradas; para uma formula UNSAT resolvida sem
+    suposicoes, a prova termina na clausula vazia.
+*/
+
+typedef enum {
+    SOLVER_DESCONHECIDO = 0,
+    SOLVER_SAT = 10,
+    SOLVER_UNSAT = 20
+} ResultadoSolver;
+
+
+typedef struct {
+    int n_literais;
+    int lbd;                //Numero de niveis distintos na clausula (qualidade da aprendida)
+    bool aprendida;
+    double atividade;
+    int literais[];
+} ClausulaSolver;
+
+
+typedef struct {
+    ClausulaSolver** itens;
+    int n, capacidade;
+} ListaClausulas;
+
+
+typedef struct {
+    int* itens;
+    int n, capacidade;
+} VetorInt;
+
+
+typedef struct {
+    int n_variaveis, capacidade_vars;
+
+    ListaClausulas originais;
+    ListaClausulas aprendidas;
+    ListaClausulas* observadores;   //Por literal: clausulas que observam o literal negado
+
+    //Estado por variavel
+    signed char* valor;             //-1 livre, 0 falso, 1 verdadeiro
+    signed char* fase;              //Ultimo valor atribuido (fase salva)
+    signed char* visto;
+    int* nivel;
+    ClausulaSolver** razao;
+    double* atividade;
+
+    //Heap de variaveis ordenado pela atividade (VSIDS)
+    int* heap;
+    int* pos_heap;
+    int tam_heap;
+    double inc_atividade;
+    double inc_clausula;
+
+    //Trilha de atribuicoes
+    int* trilha;
+    int n_trilha;
+    int inicio_propagacao;
+    VetorInt limites_nivel;
+
+    bool inconsistente;             //Clausula vazia derivada no nivel 0
+    signed char* modelo;
+    VetorInt nucleo;                //Suposicoes responsaveis pelo ultimo UNSAT
+
+    long prox_reducao;
+    long reducoes;
+    VetorInt auxiliar;
+
+    //Estatisticas acumuladas entre chamadas
+    long decisoes;
+    long propagacoes;
+    long conflitos;
+    long total_aprendidas;
+    long removidas;
+    long reinicios;
+    size_t bytes_clausulas;
+
+    //Limites da chamada atual e relatorio de progresso
+    long limite_conflitos;          //Conflitos por chamada; < 0 sem limite
+    double limite_tempo;            //Segundos por chamada; <= 0 sem limite
+    double intervalo_progresso;     //Segundos entre linhas de progresso
+    FILE* saida_progresso;          //NULL desativa o progresso
+    double inicio_chamada;
+    double prox_progresso;
+    long conflitos_inicio;
+    volatile sig_atomic_t interromper;
+
+    ProvaDRAT* prova;               //NULL desativa a prova
+
+    //Configuracao (usada para comparar variantes no benchmark)
+    bool usar_reinicios;
+    bool usar_reducao;
+} Solver;
+
+
+//Literais codificados
+static inline int lit_de_dimacs(int x) { return x > 0 ? 2 * x : 2 * (-x) + 1; }
+static inline int lit_para_dimacs(int l) { return (l & 1) ? -(l >> 1) : (l >> 1); }
+static inline int lit_var(int l) { return l >> 1; }
+static inline int lit_neg(int l) { return l ^ 1; }
+
+//Valor do literal: -1 livre, 0 falso, 1 verdadeiro
+static inline int valor_lit(const Solver* s, int l) {
+    int v = s->valor[lit_var(l)];
+    return v < 0 ? -1 : v ^ (l & 1);
+}
+
+static inline int nivel_atual(const Solver* s) { return s->limites_nivel.n; }
+
+static inline void registrar_prova(Solver* s, char tipo, const int* lits, int n) {
+    if (s->prova != NULL) prova_clausula(s->prova, tipo, lits, n);
+}
+
+
+void vetor_inserir(VetorInt* v, int x) {
+    if (v->n == v->capacidade) {
+        v->capacidade = v->capacidade ? 2 * v->capacidade : 16;
+        v->itens = (int*)realloc(v->itens, v->capacidade * sizeof(int));
+    }
+    v->itens[v->n++] = x;
+}
+
+void lista_inserir(ListaClausulas* l, ClausulaSolver* c) {
+    if (l->n == l->capacidade) {
+        l->capacidade = l->capacidade ? 2 * l->capacidade : 4;
+        l->itens = (ClausulaSolver**)realloc(l->itens, l->capacidade * sizeof(ClausulaSolver*));
+    }
+    l->itens[l->n++] = c;
+}
+
+void lista_remover(ListaClausulas* l, ClausulaSolver* c) {
+    for (int i = 0; i < l->n; i++) {
+        if (l->itens[i] == c) {
+            l->itens[i] = l->itens[--l->n];
+            return;
+        }
+    }
+}
+
+
+/*
+    Heap de atividade
+*/
+
+static inline bool heap_maior(const Solver* s, int a, int b) {
+    return s->atividade[a] > s->atividade[b];
+}
+
+void heap_subir(Solver* s, int i) {
+    int var = s->heap[i];
+    while (i > 0 && heap_maior(s, var, s->heap[(i - 1) / 2])) {
+        s->heap[i] = s->heap[(i - 1) / 2];
+        s->pos_heap[s->heap[i]] = i;
+        i = (i - 1) / 2;
+    }
+    s->heap[i] = var;
+    s->pos_heap[var] = i;
+}
+
+void heap_descer(Solver* s, int i) {
+    int var = s->heap[i];
+    while (2 * i + 1 < s->tam_heap) {
+        int filho = 2 * i + 1;
+        if (filho + 1 < s->tam_heap && heap_maior(s, s->heap[filho + 1], s->heap[filho])) filho++;
+        if (!heap_maior(s, s->heap[filho], var)) break;
+        s->heap[i] = s->heap[filho];
+        s->pos_heap[s->heap[i]] = i;
+        i = filho;
+    }
+    s->heap[i] = var;
+    s->pos_heap[var] = i;
+}
+
+void heap_inserir(Solver* s, int var) {
+    if (s->pos_heap[var] >= 0) return;
+    s->heap[s->tam_heap] = var;
+    heap_subir(s, s->tam_heap++);
+}
+
+int heap_remover_max(Solver* s) {
+    int var = s->heap[0];
+    s->pos_heap[var] = -1;
+    if (--s->tam_heap > 0) {
+        s->heap[0] = s->heap[s->tam_heap];
+        heap_descer(s, 0);
+    }
+    return var;
+}
+
+
+/*
+    Criacao e variaveis
+*/
+
+double tempo_atual(void);
+
+Solver* solver_criar(void) {
+    Solver* s = (Solver*)calloc(1, sizeof(Solver));
+    s->inicio_chamada = tempo_atual();     //Estatisticas antes da primeira chamada (UNSAT ja ao adicionar)
+    s->inc_atividade = 1.0;
+    s->inc_clausula = 1.0;
+    s->prox_reducao = 2000;
+    s->limite_conflitos = -1;
+    s->intervalo_progresso = 5.0;
+    s->usar_reinicios = true;
+    s->usar_reducao = true;
+    return s;
+}
+
+//Garante espaco para as variaveis 1..n
+void solver_reservar_variaveis(Solver* s, int n) {
+    if (n <= s->n_variaveis) return;
+
+    if (n >= s->capacidade_vars) {
+        int cap = s->capacidade_vars ? s->capacidade_vars : 16;
+        while (cap <= n) cap *= 2;
+        s->valor = (signed char*)realloc(s->valor, cap * sizeof(signed char));
+        s->fase = (signed char*)realloc(s->fase, cap * sizeof(signed char));
+        s->visto = (signed char*)realloc(s->visto, cap * sizeof(signed char));
+        s->modelo = (signed char*)realloc(s->modelo, cap * sizeof(signed char));
+        s->nivel = (int*)realloc(s->nivel, cap * sizeof(int));
+        s->razao = (ClausulaSolver**)realloc(s->razao, cap * sizeof(ClausulaSolver*));
+        s->atividade = (double*)realloc(s->atividade, cap * sizeof(double));
+        s->heap = (int*)realloc(s->heap, cap * sizeof(int));
+        s->pos_heap = (int*)realloc(s->pos_heap, cap * sizeof(int));
+        s->trilha = (int*)realloc(s->trilha, cap * sizeof(int));
+        s->observadores = (ListaClausulas*)realloc(s->observadores, 2 * cap * sizeof(ListaClausulas));
+        memset(s->observadores + 2 * s->capacidade_vars, 0,
+               2 * (cap - s->capacidade_vars) * sizeof(ListaClausulas));
+        s->capacidade_vars = cap;
+    }
+
+    for (int v = s->n_variaveis + 1; v <= n; v++) {
+        s->valor[v] = -1;
+        s->fase[v] = 0;
+        s->visto[v] = 0;
+        s->modelo[v] = -1;
+        s->nivel[v] = 0;
+        s->razao[v] = NULL;
+        s->atividade[v] = 0.0;
+        s->pos_heap[v] = -1;
+        heap_inserir(s, v);
+    }
+    s->n_variaveis = n;
+}
+
+int solver_nova_variavel(Solver* s) {
+    solver_reservar_variaveis(s, s->n_variaveis + 1);
+    return s->n_variaveis;
+}
+
+void solver_liberar(Solver* s) {
+    for (int i = 0; i < s->originais.n; i++) free(s->originais.itens[i]);
+    for (int i = 0; i < s->aprendidas.n; i++) free(s->aprendidas.itens[i]);
+    free(s->originais.itens);
+    free(s->aprendidas.itens);
+    for (int l = 0; l < 2 * s->capacidade_vars; l++) free(s->observadores[l].itens);
+    free(s->observadores);
+    free(s->valor);
+    free(s->fase);
+    free(s->visto);
+    free(s->modelo);
+    free(s->nivel);
+    free(s->razao);
+    free(s->atividade);
+    free(s->heap);
+    free(s->pos_heap);
+    free(s->trilha);
+    free(s->limites_nivel.itens);
+    free(s->nucleo.itens);
+    free(s->auxiliar.itens);
+    free(s);
+}
+
+
+/*
+    Atribuicao, propagacao e retrocesso
+*/
+
+void atribuir(Solver* s, int l, ClausulaSolver* razao) {
+    int v = lit_var(l);
+    s->valor[v] = (signed char)!(l & 1);
+    s->nivel[v] = nivel_atual(s);
+    s->razao[v] = razao;
+    s->trilha[s->n_trilha++] = l;
+}
+
+void retroceder(Solver* s, int nivel) {
+    if (nivel_atual(s) <= nivel) return;
+    int limite = s->limites_nivel.itens[nivel];
+    for (int i = s->n_trilha - 1; i >= limite; i--) {
+        int v = lit_var(s->trilha[i]);
+        s->fase[v] = s->valor[v];
+        s->valor[v] = -1;
+        s->razao[v] = NULL;
+        heap_inserir(s, v);
+    }
+    s->n_trilha = limite;
+    s->inicio_propagacao = limite;
+    s->limites_nivel.n = nivel;
+}
+
+void observar(Solver* s, ClausulaSolver* c) {
+    lista_inserir(&s->observadores[lit_neg(c->literais[0])], c);
+    lista_inserir(&s->observadores[lit_neg(c->literais[1])], c);
+}
+
+//Propagacao unitaria com dois literais observados; retorna a clausula em conflito
+ClausulaSolver* propagar(Solver* s) {
+    while (s->inicio_propagacao < s->n_trilha) {
+        int p = s->trilha[s->inicio_propagacao++];
+        s->propagacoes++;
+        int falso = lit_neg(p);
+        ListaClausulas* obs = &s->observadores[p];
+        int i = 0, j = 0;
+
+        while (i < obs->n) {
+            ClausulaSolver* c = obs->itens[i++];
+
+            //Mantem o literal falso na posicao 1
+            if (c->literais[0] == falso) {
+                c->literais[0] = c->literais[1];
+                c->literais[1] = falso;
+            }
+            if (valor_lit(s, c->literais[0]) == 1) {
+                obs->itens[j++] = c;
+                continue;
+            }
+
+            //Procura um novo literal para observar
+            bool achou = false;
+            for (int k = 2; k < c->n_literais; k++) {
+                if (valor_lit(s, c->literais[k]) != 0) {
+                    c->literais[1] = c->literais[k];
+                    c->literais[k] = falso;
+                    lista_inserir(&s->observadores[lit_neg(c->literais[1])], c);
+                    achou = true;
+                    break;
+                }
+            }
+            if (achou) continue;
+
+            obs->itens[j++] = c;
+            if (valor_lit(s, c->literais[0]) == 0) {
+                //Conflito: preserva os observadores restantes
+                while (i < obs->n) obs->itens[j++] = obs->itens[i++];
+                obs->n = j;
+                s->inicio_propagacao = s->n_trilha;
+                return c;
+            }
+            atribuir(s, c->literais[0], c);
+        }
+        obs->n = j;
+    }
+    return NULL;
+}
+
+
+/*
+    Adicao de clausulas (sempre no nivel 0)
+*/
+
+ClausulaSolver* nova_clausula(Solver* s, const int* lits, int n, bool aprendida) {
+    ClausulaSolver* c = (ClausulaSolver*)malloc(sizeof(ClausulaSolver) + n * sizeof(int));
+    s->bytes_clausulas += sizeof(ClausulaSolver) + n * sizeof(int);
+    c->n_literais = n;
+    c->lbd = n;
+    c->aprendida = aprendida;
+    c->atividade = 0.0;
+    memcpy(c->literais, lits, n * sizeof(int));
+    return c;
+}
+
+//Adiciona uma clausula em formato DIMACS; retorna false se a formula ficou UNSAT
+bool solver_adicionar_clausula(Solver* s, const int* literais, int n) {
+    if (s->inconsistente) return false;
+    retroceder(s, 0);
+
+    VetorInt* aux = &s->auxiliar;
+    aux->n = 0;
+    bool encurtada = false;
+    for (int i = 0; i < n; i++) {
+        solver_reservar_variaveis(s, abs(literais[i]));
+        int l = lit_de_dimacs(literais[i]);
+        int v = valor_lit(s, l);
+        if (v == 1) return true;          //Ja satisfeita no nivel 0
+        if (v == 0) {                     //Literal falso no nivel 0 e descartado
+            encurtada = true;
+            continue;
+        }
+
+        bool repetido = false;
+        for (int j = 0; j < aux->n; j++) {
+            if (aux->itens[j] == lit_neg(l)) return true;    //Tautologia
+            if (aux->itens[j] == l) repetido = true;
+        }
+        if (!repetido) vetor_inserir(aux, l);
+    }
+
+    //A versao encurtada e consequencia por propagacao unitaria e entra na prova
+    if (encurtada) registrar_prova(s, 'a', aux->itens, aux->n);
+
+    if (aux->n == 0) {
+        s->inconsistente = true;
+        return false;
+    }
+    if (aux->n == 1) {
+        atribuir(s, aux->itens[0], NULL);
+        if (propagar(s) != NULL) {
+            s->inconsistente = true;
+            registrar_prova(s, 'a', NULL, 0);
+        }
+        return !s->inconsistente;
+    }
+
+    ClausulaSolver* c = nova_clausula(s, aux->itens, aux->n, false);
+    lista_inserir(&s->originais, c);
+    observar(s, c);
+    return true;
+}
+
+bool solver_adicionar_formula(Solver* s, const Formula* formula) {
+    solver_reservar_variaveis(s, formula->n_variaveis);
+    for (int i = 0; i < formula->n_clausulas; i++) {
+        const Clausula* c = &formula->clausulas[i];
+        if (!solver_adicionar_clausula(s, c->literais, c->num_literais)) return false;
+    }
+    return true;
+}
+
+
+/*
+    Analise de conflitos
+*/
+
+void aumentar_atividade_var(Solver* s, int v) {
+    if ((s->atividade[v] += s->inc_atividade) > 1e100) {
+        for (int i = 1; i <= s->n_variaveis; i++) s->atividade[i] *= 1e-100;
+        s->inc_atividade *= 1e-100;
+    }
+    if (s->pos_heap[v] >= 0) heap_subir(s, s->pos_heap[v]);
+}
+
+void aumentar_atividade_clausula(Solver* s, ClausulaSolver* c) {
+    if ((c->atividade += s->inc_clausula) > 1e20) {
+        for (int i = 0; i < s->aprendidas.n; i++) s->aprendidas.itens[i]->atividade *= 1e-20;
+        s->inc_clausula *= 1e-20;
+    }
+}
+
+int calcular_lbd(Solver* s, const int* lits, int n) {
+    VetorInt* aux = &s->auxiliar;
+    aux->n = 0;
+    for (int i = 0; i < n; i++) {
+        int nv = s->nivel[lit_var(lits[i])];
+        bool novo = true;
+        for (int j = 0; j < aux->n && novo; j++) novo = aux->itens[j] != nv;
+        if (novo) vetor_inserir(aux, nv);
+    }
+    return aux->n;
+}
+
+//Literal redundante: todos os antecedentes ja estao na clausula ou no nivel 0
+bool redundante(const Solver* s, int l) {
+    ClausulaSolver* r = s->razao[lit_var(l)];
+    if (r == NULL) return false;
+    for (int k = 1; k < r->n_literais; k++) {
+        int v = lit_var(r->literais[k]);
+        if (!s->visto[v] && s->nivel[v] > 0) return false;
+    }
+    return true;
+}
+
+//Aprende a clausula do primeiro UIP; o literal assertivo fica em aprendida[0]
+void analisar(Solver* s, ClausulaSolver* conflito, VetorInt* aprendida, int* nivel_retorno) {
+    int caminhos = 0;
+    int p = -1;
+    int idx = s->n_trilha - 1;
+
+    aprendida->n = 0;
+    vetor_inserir(aprendida, -1);
+
+    do {
+        if (conflito->aprendida) aumentar_atividade_clausula(s, conflito);
+
+        for (int k = (p == -1) ? 0 : 1; k < conflito->n_literais; k++) {
+            int q = conflito->literais[k];
+            int v = lit_var(q);
+            if (!s->visto[v] && s->nivel[v] > 0) {
+                s->visto[v] = 1;
+                aumentar_atividade_var(s, v);
+                if (s->nivel[v] >= nivel_atual(s)) caminhos++;
+                else vetor_inserir(aprendida, q);
+            }
+        }
+
+        while (!s->visto[lit_var(s->trilha[idx])]) idx--;
+        p = s->trilha[idx--];
+        conflito = s->razao[lit_var(p)];
+        s->visto[lit_var(p)] = 0;
+        caminhos--;
+    } while (caminhos > 0);
+
+    aprendida->itens[0] = lit_neg(p);
+
+    //Minimizacao local; os literais removidos ficam em auxiliar para desmarcar depois
+    VetorInt* removidos = &s->auxiliar;
+    removidos->n = 0;
+    int j = 1;
+    for (int i = 1; i < aprendida->n; i++) {
+        if (redundante(s, aprendida->itens[i])) vetor_inserir(removidos, aprendida->itens[i]);
+        else aprendida->itens[j++] = aprendida->itens[i];
+    }
+    aprendida->n = j;
+
+    //O literal de maior nivel (apos o assertivo) vai para a posicao 1
+    *nivel_retorno = 0;
+    if (aprendida->n > 1) {
+        int max_i = 1;
+        for (int i = 2; i < aprendida->n; i++) {
+            if (s->nivel[lit_var(aprendida->itens[i])] > s->nivel[lit_var(aprendida->itens[max_i])]) max_i = i;
+        }
+        int tmp = aprendida->itens[1];
+        aprendida->itens[1] = aprendida->itens[max_i];
+        aprendida->itens[max_i] = tmp;
+        *nivel_retorno = s->nivel[lit_var(aprendida->itens[1])];
+    }
+
+    for (int i = 0; i < aprendida->n; i++) s->visto[lit_var(aprendida->itens[i])] = 0;
+    for (int i = 0; i < removidos->n; i++) s->visto[lit_var(removidos->itens[i])] = 0;
+}
+
+//Calcula quais suposicoes levaram o literal p a ser falso
+void analisar_final(Solver* s, int p) {
+    s->nucleo.n = 0;
+    vetor_inserir(&s->nucleo, lit_para_dimacs(lit_neg(p)));
+    if (nivel_atual(s) == 0) return;
+
+    s->visto[lit_var(p)] = 1;
+    for (int i = s->n_trilha - 1; i >= s->limites_nivel.itens[0]; i--) {
+        int v = lit_var(s->trilha[i]);
+        if (!s->visto[v]) continue;
+        if (s->razao[v] == NULL) {
+            //Decisao dentro dos niveis de suposicao: e a propria suposicao
+            vetor_inserir(&s->nucleo, lit_para_dimacs(s->trilha[i]));
+        } else {
+            ClausulaSolver* r = s->razao[v];
+            for (int k = 1; k < r->n_literais; k++) {
+                if (s->nivel[lit_var(r->literais[k])] > 0) s->visto[lit_var(r->literais[k])] = 1;
+            }
+        }
+        s->visto[v] = 0;
+    }
+    s->visto[lit_var(p)] = 0;
+}
+
+
+/*
+    Reducao da base de clausulas aprendidas
+*/
+
+//Clausula e razao de uma atribuicao atual e nao pode ser removida
+bool travada(const Solver* s, const ClausulaSolver* c) {
+    int v = lit_var(c->literais[0]);
+    return s->razao[v] == c && valor_lit(s, c->literais[0]) == 1;
+}
+
+int comparar_aprendidas(const void* a, const void* b) {
+    const ClausulaSolver* x = *(ClausulaSolver* const*)a;
+    const ClausulaSolver* y = *(ClausulaSolver* const*)b;
+    if (x->lbd != y->lbd) return y->lbd - x->lbd;
+    return (x->atividade < y->atividade) ? -1 : (x->atividade > y->atividade);
+}
+
+void remover_clausula(Solver* s, ClausulaSolver* c) {
+    lista_remover(&s->observadores[lit_neg(c->literais[0])], c);
+    lista_remover(&s->observadores[lit_neg(c->literais[1])], c);
+    s->bytes_clausulas -= sizeof(ClausulaSolver) + c->n_literais * sizeof(int);
+    s->removidas++;
+    registrar_prova(s, 'd', c->literais, c->n_literais);
+    free(c);
+}
+
+//Remove metade das aprendidas (piores LBD e menor atividade primeiro), preservando as "glue"
+void reduzir_aprendidas(Solver* s) {
+    ListaClausulas* l = &s->aprendidas;
+    qsort(l->itens, l->n, sizeof(ClausulaSolver*), comparar_aprendidas);
+
+    int remover = l->n / 2;
+    int j = 0;
+    for (int i = 0; i < l->n; i++) {
+        ClausulaSolver* c = l->itens[i];
+        if (remover > 0 && c->lbd > 2 && !travada(s, c)) {
+            remover_clausula(s, c);
+            remover--;
+        } else {
+            l->itens[j++] = c;
+        }
+    }
+    l->n = j;
+}
+
+
+/*
+    Estatisticas e limites
+*/
+
+double tempo_atual(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+//Memoria aproximada do solver: clausulas, listas de observadores e vetores por variavel
+size_t solver_memoria(const Solver* s) {
+    size_t total = s->bytes_clausulas;
+    total += (size_t)(s->originais.capacidade + s->aprendidas.capacidade) * sizeof(ClausulaSolver*);
+    for (int l = 0; l < 2 * s->capacidade_vars; l++) {
+        total += (size_t)s->observadores[l].capacidade * sizeof(ClausulaSolver*);
+    }
+    total += (size_t)s->capacidade_vars * (4 * sizeof(signed char) + 4 * sizeof(int) +
+                                           sizeof(ClausulaSolver*) + sizeof(double) +
+                                           2 * sizeof(ListaClausulas));
+    return total;
+}
+
+//Linha no formato "c <rotulo> chave=valor ..." para ser lida por scripts
+void solver_imprimir_estatisticas(const Solver* s, FILE* saida, const char* rotulo) {
+    fprintf(saida, "c %s tempo=%.3f decisoes=%ld propagacoes=%ld conflitos=%ld "
+            "aprendidas=%ld aprendidas_ativas=%d removidas=%ld reinicios=%ld memoria_kb=%zu\n",
+            rotulo, tempo_atual() - s->inicio_chamada, s->decisoes, s->propagacoes, s->conflitos,
+            s->total_aprendidas, s->aprendidas.n, s->removidas, s->reinicios,
+            solver_memoria(s) / 1024);
+    fflush(saida);
+}
+
+//Pode ser chamada de um tratador de sinal: a chamada atual retorna SOLVER_DESCONHECIDO
+void solver_interromper(Solver* s) {
+    s->interromper = 1;
+}
+
+//Verifica interrupcao e limites e emite progresso; retorna true se a busca deve parar.
+//O relogio so e consultado quando pedido, para manter o custo baixo no laco principal
+bool limite_atingido(Solver* s, bool consultar_relogio) {
+    if (s->interromper) return true;
+    if (s->limite_conflitos >= 0 && s->conflitos - s->conflitos_inicio >= s->limite_conflitos) return true;
+    if (!consultar_relogio) return false;
+
+    double agora = tempo_atual();
+    if (s->limite_tempo > 0 && agora - s->inicio_chamada >= s->limite_tempo) return true;
+    if (s->saida_progresso != NULL && agora >= s->prox_progresso) {
+        solver_imprimir_estatisticas(s, s->saida_progresso, "progresso");
+        s->prox_progresso = agora + s->intervalo_progresso;
+    }
+    return false;
+}
+
+
+/*
+    Busca
+*/
+
+#define REINICIAR_BUSCA -1
+
+//Sequencia de Luby para os intervalos entre reinicios
+double luby(double y, int x) {
+    int tamanho = 1, seq = 0;
+    while (tamanho < x + 1) {
+        seq++;
+        tamanho = 2 * tamanho + 1;
+    }
+    while (tamanho - 1 != x) {
+        tamanho = (tamanho - 1) >> 1;
+        seq--;
+        x = x % tamanho;
+    }
+    double r = 1;
+    for (int i = 0; i < seq; i++) r *= y;
+    return r;
+}
+
+int escolher_decisao(Solver* s) {
+    while (s->tam_heap > 0) {
+        int v = heap_remover_max(s);
+        if (s->valor[v] == -1) return s->fase[v] ? 2 * v : 2 * v + 1;
+    }
+    return -1;
+}
+
+//Busca CDCL ate um reinicio (REINICIAR_BUSCA), SAT, UNSAT ou limite atingido (DESCONHECIDO)
+int buscar(Solver* s, const int* suposicoes, int n_suposicoes, long limite_conflitos) {
+    VetorInt aprendida = {0};
+    long conflitos_busca = 0;
+    int resultado = REINICIAR_BUSCA;
+
+    for (;;) {
+        ClausulaSolver* conflito = propagar(s);
+
+        if (conflito != NULL) {
+            s->conflitos++;
+            conflitos_busca++;
+            if (nivel_atual(s) == 0) {
+                s->inconsistente = true;
+                s->nucleo.n = 0;
+                registrar_prova(s, 'a', NULL, 0);
+                resultado = SOLVER_UNSAT;
+                break;
+            }
+
+            int nivel_retorno;
+            analisar(s, conflito, &aprendida, &nivel_retorno);
+            retroceder(s, nivel_retorno);
+            registrar_prova(s, 'a', aprendida.itens, aprendida.n);
+
+            if (aprendida.n == 1) {
+                atribuir(s, aprendida.itens[0], NULL);
+            } else {
+                ClausulaSolver* c = nova_clausula(s, aprendida.itens, aprendida.n, true);
+                s->total_aprendidas++;
+                c->lbd = calcular_lbd(s, c->literais, c->n_literais);
+                aumentar_atividade_clausula(s, c);
+                lista_inserir(&s->aprendidas, c);
+                observar(s, c);
+                atribuir(s, c->literais[0], c);
+            }
+
+            s->inc_atividade *= 1.0 / 0.95;
+            s->inc_clausula *= 1.0 / 0.999;
+            if (limite_atingido(s, (s->conflitos & 255) == 0)) {
+                resultado = SOLVER_DESCONHECIDO;
+                break;
+            }
+            continue;
+        }
+
+        if (conflitos_busca >= limite_conflitos) {
+            retroceder(s, 0);
+            break;
+        }
+        if (limite_atingido(s, (s->decisoes & 4095) == 0)) {
+            resultado = SOLVER_DESCONHECIDO;
+            break;
+        }
+        if (s->usar_reducao && s->conflitos >= s->prox_reducao) {
+            s->prox_reducao = s->conflitos + 2000 + 300 * ++s->reducoes;
+            reduzir_aprendidas(s);
+        }
+
+        //Suposicoes sao decididas primeiro, uma por nivel
+        int proximo = -1;
+        while (nivel_atual(s) < n_suposicoes) {
+            int p = lit_de_dimacs(suposicoes[nivel_atual(s)]);
+            int v = valor_lit(s, p);
+            if (v == 1) {
+                vetor_inserir(&s->limites_nivel, s->n_trilha);    //Nivel vazio
+            } else if (v == 0) {
+                analisar_final(s, lit_neg(p));
+                resultado = SOLVER_UNSAT;
+                break;
+            } else {
+                proximo = p;
+                break;
+            }
+        }
+        if (resultado != REINICIAR_BUSCA) break;
+
+        if (proximo == -1) {
+            proximo = escolher_decisao(s);
+            if (proximo == -1) {
+                resultado = SOLVER_SAT;
+                break;
+            }
+        }
+
+        s->decisoes++;
+        vetor_inserir(&s->limites_nivel, s->n_trilha);
+        atribuir(s, proximo, NULL);
+    }
+
+    free(aprendida.itens);
+    return resultado;
+}
+
+//Resolve a formula atual sob as suposicoes dadas (literais DIMACS)
+ResultadoSolver solver_resolver(Solver* s, const int* suposicoes, int n_suposicoes) {
+    s->nucleo.n = 0;
+    if (s->inconsistente) return SOLVER_UNSAT;
+
+    for (int i = 0; i < n_suposicoes; i++) {
+        solver_reservar_variaveis(s, abs(suposicoes[i]));
+    }
+
+    s->inicio_chamada = tempo_atual();
+    s->prox_progresso = s->inicio_chamada + s->intervalo_progresso;
+    s->conflitos_inicio = s->conflitos;
+
+    int resultado = REINICIAR_BUSCA;
+    for (int reinicio = 0; resultado == REINICIAR_BUSCA; reinicio++) {
+        if (reinicio > 0) s->reinicios++;
+        long limite = s->usar_reinicios ? (long)(100 * luby(2, reinicio)) : LONG_MAX;
+        resultado = buscar(s, suposicoes, n_suposicoes, limite);
+    }
+
+    if (resultado == SOLVER_SAT) {
+        for (int v = 1; v <= s->n_variaveis; v++) s->modelo[v] = s->valor[v];
+    }
+    retroceder(s, 0);
+    s->interromper = 0;
+    return (ResultadoSolver)resultado;
+}
+
+//Valor da variavel no ultimo modelo encontrado: 1, 0 ou -1 (desconhecida)
+int solver_valor(const Solver* s, int var) {
+    if (var < 1 || var > s->n_variaveis) return -1;
+    return s->modelo[var];
+}
+
+//Suposicoes (em DIMACS) que bastam para o ultimo UNSAT; vazio se a formula e UNSAT sem elas
+const int* solver_nucleo(const Solver* s, int* n) {
+    *n = s->nucleo.n;
+    return s->nucleo.itens;
+}
+
+#endif
@@ -0,0 +1,307 @@
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "formula.h"
+
+/*
+    VERIFICADOR DE PROVAS DRAT
+
+    Confere, do inicio para o fim, uma prova DRAT binaria gravada por
+    main --prova (formato em prova_drat.h) contra a formula original:
+
+      - cada clausula adicionada ('a') precisa ser RUP: atribuindo falso a
+        todos os seus literais, a propagacao unitaria sobre a formula e as
+        clausulas ja aceitas chega a um conflito
+      - a prova precisa terminar por derivar a clausula vazia
+
+    O solver CDCL so adiciona clausulas aprendidas (e versoes encurtadas
+    delas), que sao sempre RUP; clausulas que precisariam da regra RAT sao
+    rejeitadas. Remocoes ('d') sao lidas e ignoradas: sem elas a base de
+    clausulas so fica maior, e uma clausula RUP sobre uma base maior que a
+    do solver continua sendo consequencia da formula original.
+
+    A propagacao usa dois literais observados por clausula, com os literais
+    na codificacao interna do solver (2*x para x, 2*x+1 para -x).
+
+    Uso: verificador_drat formula.cnf prova.drat
+    Saida: "s VERIFICADA" (retorno 0) ou "s NAO VERIFICADA" (retorno 1)
+*/
+
+typedef struct {
+    int* itens;
+    int n, capacidade;
+} ListaInt;
+
+static void lista_adicionar(ListaInt* l, int x) {
+    if (l->n == l->capacidade) {
+        l->capacidade = l->capacidade ? 2 * l->capacidade : 4;
+        l->itens = (int*)realloc(l->itens, l->capacidade * sizeof(int));
+    }
+    l->itens[l->n++] = x;
+}
+
+typedef struct {
+    int n_variaveis;
+    int* valor;             //Por variavel: -1 livre, 0 falso, 1 verdadeiro
+    int* marca;             //Por variavel: auxiliar de normalizar()
+    int* trilha;            //Literais verdadeiros, na ordem em que foram atribuidos
+    int n_trilha, propagados;
+    ListaInt* observadores; //Por literal: clausulas que o observam
+    int** clausulas;        //Os dois primeiros literais sao os observados
+    int* tamanho;
+    int n_clausulas, capacidade_clausulas;
+    bool inconsistente;     //A propagacao no nivel 0 ja chegou a um conflito
+} Verificador;
+
+static inline int valor_literal(const Verificador* v, int lit) {
+    int x = v->valor[lit >> 1];
+    return x < 0 ? -1 : x ^ (lit & 1);
+}
+
+static inline void atribuir(Verificador* v, int lit) {
+    v->valor[lit >> 1] = !(lit & 1);
+    v->trilha[v->n_trilha++] = lit;
+}
+
+//Retorna false em conflito
+static bool propagar(Verificador* v) {
+    while (v->propagados < v->n_trilha) {
+        int falso = v->trilha[v->propagados++] ^ 1;
+        ListaInt* obs = &v->observadores[falso];
+        int mantidos = 0;
+        for (int i = 0; i < obs->n; i++) {
+            int c = obs->itens[i];
+            int* lits = v->clausulas[c];
+            if (lits[0] == falso) {
+                lits[0] = lits[1];
+                lits[1] = falso;
+            }
+            if (valor_literal(v, lits[0]) == 1) {
+                obs->itens[mantidos++] = c;
+                continue;
+            }
+            //Procura outro literal nao falso para observar
+            bool trocou = false;
+            for (int k = 2; k < v->tamanho[c]; k++) {
+                if (valor_literal(v, lits[k]) != 0) {
+                    lits[1] = lits[k];
+                    lits[k] = falso;
+                    lista_adicionar(&v->observadores[lits[1]], c);
+                    trocou = true;
+                    break;
+                }
+            }
+            if (trocou) continue;
+
+            obs->itens[mantidos++] = c;
+            if (valor_literal(v, lits[0]) == 0) {
+                //Conflito: mantem o resto da lista intacto
+                for (i++; i < obs->n; i++) obs->itens[mantidos++] = obs->itens[i];
+                obs->n = mantidos;
+                return false;
+            }
+            atribuir(v, lits[0]);
+        }
+        obs->n = mantidos;
+    }
+    return true;
+}
+
+static void desfazer(Verificador* v, int n_trilha) {
+    while (v->n_trilha > n_trilha) v->valor[v->trilha[--v->n_trilha] >> 1] = -1;
+    v->propagados = n_trilha;
+}
+
+//Adiciona uma clausula a base (sem repeticoes de literal) e propaga no nivel 0
+static void adicionar_clausula(Verificador* v, const int* lits, int n) {
+    if (v->inconsistente) return;
+
+    //Ordena os literais nao falsos na frente
+    int* c = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    int frente = 0, fim = n;
+    for (int i = 0; i < n; i++) {
+        if (valor_literal(v, lits[i]) == 1) {
+            free(c);    //Ja satisfeita no nivel 0
+            return;
+        }
+        if (valor_literal(v, lits[i]) < 0) c[frente++] = lits[i];
+        else c[--fim] = lits[i];
+    }
+
+    if (frente == 0) {
+        v->inconsistente = true;
+        free(c);
+        return;
+    }
+    if (frente == 1) {
+        atribuir(v, c[0]);
+        if (!propagar(v)) v->inconsistente = true;
+        if (n < 2) {
+            free(c);
+            return;
+        }
+    }
+
+    if (v->n_clausulas == v->capacidade_clausulas) {
+        v->capacidade_clausulas = v->capacidade_clausulas ? 2 * v->capacidade_clausulas : 64;
+        v->clausulas = (int**)realloc(v->clausulas, v->capacidade_clausulas * sizeof(int*));
+        v->tamanho = (int*)realloc(v->tamanho, v->capacidade_clausulas * sizeof(int));
+    }
+    int id = v->n_clausulas++;
+    v->clausulas[id] = c;
+    v->tamanho[id] = n;
+    lista_adicionar(&v->observadores[c[0]], id);
+    lista_adicionar(&v->observadores[c[1]], id);
+}
+
+//Remove literais repetidos; retorna false se a clausula for tautologia
+static bool normalizar(Verificador* v, int* lits, int* n) {
+    int m = 0;
+    bool tautologia = false;
+    for (int i = 0; i < *n; i++) {
+        int x = lits[i] >> 1;
+        int sinal = 1 + (lits[i] & 1);
+        if (v->marca[x] == sinal) continue;
+        if (v->marca[x] != 0) tautologia = true;
+        v->marca[x] = sinal;
+        lits[m++] = lits[i];
+    }
+    for (int i = 0; i < m; i++) v->marca[lits[i] >> 1] = 0;
+    *n = m;
+    return !tautologia;
+}
+
+//Verdadeiro se a clausula e consequencia da base por propagacao unitaria
+static bool rup(Verificador* v, const int* lits, int n) {
+    if (v->inconsistente) return true;
+    int n_trilha = v->n_trilha;
+    bool conflito = false;
+    for (int i = 0; i < n && !conflito; i++) {
+        int val = valor_literal(v, lits[i]);
+        if (val == 1) conflito = true;
+        else if (val < 0) atribuir(v, lits[i] ^ 1);
+    }
+    if (!conflito) conflito = !propagar(v);
+    desfazer(v, n_trilha);
+    return conflito;
+}
+
+static int codificar(int literal) {
+    return literal > 0 ? 2 * literal : 2 * -literal + 1;
+}
+
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        printf("Uso: %s formula.cnf prova.drat\n", argv[0]);
+        return 2;
+    }
+    Formula F = ler_formula(argv[1]);
+
+    FILE* arquivo = fopen(argv[2], "rb");
+    if (arquivo == NULL) {
+        printf("Erro ao abrir o arquivo %s.\n", argv[2]);
+        return 2;
+    }
+
+    //Le a prova inteira: o maior literal define o numero de variaveis
+    ListaInt passos = {NULL, 0, 0};   //tipo, n, literais..., por passo
+    int maior = F.n_variaveis;
+    int c;
+    bool truncada = false;
+    while ((c = getc(arquivo)) != EOF) {
+        if (c != 'a' && c != 'd') {
+            printf("c byte inesperado 0x%02x na prova\n", c);
+            truncada = true;
+            break;
+        }
+        lista_adicionar(&passos, c);
+        int pos_n = passos.n;
+        lista_adicionar(&passos, 0);
+        for (;;) {
+            unsigned int u = 0;
+            int deslocamento = 0, b;
+            do {
+                b = getc(arquivo);
+                if (b == EOF) break;
+                u |= (unsigned int)(b & 127) << deslocamento;
+                deslocamento += 7;
+            } while (b & 128);
+            if (b == EOF) {
+                truncada = true;
+                break;
+            }
+            if (u == 0) break;
+            if ((int)(u >> 1) > maior) maior = (int)(u >> 1);
+            lista_adicionar(&passos, (int)u);
+            passos.itens[pos_n]++;
+        }
+        if (truncada) {
+            printf("c prova truncada\n");
+            passos.n = pos_n - 1;
+            break;
+        }
+    }
+    fclose(arquivo);
+
+    Verificador v;
+    memset(&v, 0, sizeof(v));
+    v.n_variaveis = maior;
+    v.valor = (int*)malloc((maior + 1) * sizeof(int));
+    for (int x = 0; x <= maior; x++) v.valor[x] = -1;
+    v.marca = (int*)calloc(maior + 1, sizeof(int));
+    v.trilha = (int*)malloc((maior + 1) * sizeof(int));
+    v.observadores = (ListaInt*)calloc(2 * (maior + 1), sizeof(ListaInt));
+
+    int maior_clausula = 1;
+    for (int i = 0; i < F.n_clausulas; i++)
+        if (F.clausulas[i].num_literais > maior_clausula) maior_clausula = F.clausulas[i].num_literais;
+    int* aux = (int*)malloc(maior_clausula * sizeof(int));
+    for (int i = 0; i < F.n_clausulas; i++) {
+        int n = 0;
+        for (int j = 0; j < F.clausulas[i].num_literais; j++) aux[n++] = codificar(F.clausulas[i].literais[j]);
+        if (normalizar(&v, aux, &n)) adicionar_clausula(&v, aux, n);
+    }
+
+    long adicionadas = 0, removidas = 0;
+    bool vazia = false, ok = true;
+    for (int p = 0; p < passos.n && ok && !vazia; ) {
+        int tipo = passos.itens[p], n = passos.itens[p + 1];
+        int* lits = &passos.itens[p + 2];
+        p += 2 + n;
+        if (tipo == 'd') {
+            removidas++;
+            continue;
+        }
+        adicionadas++;
+        bool valida = normalizar(&v, lits, &n);
+        if (valida && !rup(&v, lits, n)) {
+            printf("c passo %ld nao e RUP:", adicionadas);
+            for (int i = 0; i < n; i++) printf(" %d", lits[i] & 1 ? -(lits[i] >> 1) : lits[i] >> 1);
+            printf(" 0\n");
+            ok = false;
+            break;
+        }
+        if (n == 0) vazia = true;
+        else if (valida) adicionar_clausula(&v, lits, n);
+    }
+
+    printf("c %ld clausulas adicionadas, %ld remocoes ignoradas\n", adicionadas, removidas);
+    if (ok && !vazia) printf("c a prova nao deriva a clausula vazia\n");
+    bool verificada = ok && vazia && !truncada;
+    printf("s %s\n", verificada ? "VERIFICADA" : "NAO VERIFICADA");
+
+    for (int i = 0; i < v.n_clausulas; i++) free(v.clausulas[i]);
+    for (int l = 0; l < 2 * (maior + 1); l++) free(v.observadores[l].itens);
+    free(v.clausulas);
+    free(v.tamanho);
+    free(v.observadores);
+    free(v.valor);
+    free(v.marca);
+    free(v.trilha);
+    free(aux);
+    free(passos.itens);
+    liberar_formula(&F);
+    return verificada ? 0 : 1;
+}
@@ -0,0 +1,32 @@
+#!/bin/sh
+# Gera as instancias UNSAT do benchmark (casa dos pombos e paridade), resolve
+# cada uma com main --prova e confere a prova com verificador_drat.
+# Uso: ./verificar_provas.sh [escala]      (retorno 0 se todas as provas conferem)
+
+set -e
+cd "$(dirname "$0")"
+escala=${1:-1}
+dir=$(mktemp -d)
+trap 'rm -rf "$dir"' EXIT
+
+gcc -O2 -pthread main.c -o "$dir/main" -lm
+gcc -O2 -pthread benchmark.c -o "$dir/benchmark" -lm
+gcc -O2 verificador_drat.c -o "$dir/verificador_drat" -lm
+"$dir/benchmark" --escala "$escala" --exportar "$dir" > /dev/null
+
+falhas=0
+for cnf in "$dir"/pombos-*.cnf "$dir"/paridade-*-unsat.cnf; do
+    nome=$(basename "$cnf" .cnf)
+    if ! "$dir/main" --progresso 0 --prova "$dir/$nome.drat" "$cnf" 2> /dev/null | grep -q "UNSAT"; then
+        echo "$nome: o solver nao respondeu UNSAT"
+        falhas=$((falhas + 1))
+    elif "$dir/verificador_drat" "$cnf" "$dir/$nome.drat" > "$dir/$nome.log"; then
+        echo "$nome: prova verificada"
+    else
+        echo "$nome: prova NAO verificada"
+        sed 's/^/    /' "$dir/$nome.log"
+        falhas=$((falhas + 1))
+    fi
+done
+
+[ "$falhas" -eq 0 ]
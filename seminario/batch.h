@@ -0,0 +1,368 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <limits.h>
+#include "priority_queue.h"
+
+/*
+    Modo em lote
+
+    Reproduz um trace de chegadas sem imprimir nada por ciclo e, no fim,
+    grava um resumo em CSV. O trace vem de um arquivo ou de um gerador com
+    taxa e distribuicoes configuraveis; as chegadas sao lidas sob demanda,
+    entao o consumo de memoria depende so do tamanho da fila.
+
+    Arquivo de trace: uma chegada por linha, em ordem de ciclo, no formato
+        ciclo id prioridade tipo ciclos_necessarios
+    com tipo 'i' ou 'b'. Linhas iniciadas por '#' sao ignoradas.
+
+    Tempo de espera: ciclos entre a chegada e o fim em que o processo estava
+    na fila sem executar. Um processo passa fome se esperar mais que
+    starvation_limit ciclos (contando tambem os que ainda estao na fila).
+*/
+
+typedef struct {
+    int cycle;
+    int id;
+    int priority;
+    char type;
+    int required_cycles;
+} Arrival;
+
+typedef enum {
+    SERVICE_UNIFORM,       //Uniforme em 1 .. 2 * media - 1 (media 3: o mesmo 1..5 da simulacao)
+    SERVICE_GEOMETRIC,     //Geometrica (exponencial discreta)
+    SERVICE_PARETO         //Cauda pesada, alfa 1.5
+} ServiceDistribution;
+
+typedef struct {
+    double rate;           //Chegadas por ciclo (Poisson)
+    double mean_service;   //Ciclos necessarios em media
+    ServiceDistribution service;
+    double interactive;    //Fracao de processos interativos
+    unsigned long long seed;
+} GeneratorConfig;
+
+typedef struct {
+    FILE *file;            //NULL: usa o gerador
+    GeneratorConfig generator;
+    unsigned long long rng;
+    int cycle;             //Ciclo da proxima rodada de chegadas do gerador
+    int pending;           //Chegadas ainda nao entregues no ciclo atual
+    int next_id;
+    double poisson_limit;  //exp(-rate): probabilidade de um ciclo sem chegadas
+    long line;
+    int last_cycle;        //Ciclo da linha anterior: o arquivo precisa estar em ordem de ciclo
+    int error;             //Linha invalida no arquivo
+} TraceSource;
+
+
+/*
+    Fontes de chegadas
+*/
+
+//xorshift64*, reprodutivel em qualquer plataforma
+unsigned int trace_random(TraceSource *source) {
+    source->rng ^= source->rng >> 12;
+    source->rng ^= source->rng << 25;
+    source->rng ^= source->rng >> 27;
+    return (unsigned int)((source->rng * 2685821657736338717ULL) >> 32);
+}
+
+//Uniforme em (0, 1)
+double trace_uniform(TraceSource *source) {
+    return (trace_random(source) + 0.5) / 4294967296.0;
+}
+
+/*
+    Chegadas de Poisson sem sortear todos os ciclos: o numero de ciclos vazios
+    ate a proxima chegada e geometrico, e o numero de chegadas nesse ciclo
+    segue a Poisson condicionada a ser pelo menos 1 (inversa da acumulada).
+    Retorna o numero de chegadas e avanca source->cycle ate o ciclo delas
+*/
+int poisson_next(TraceSource *source) {
+    double rate = source->generator.rate, limit = source->poisson_limit;
+    //Com taxas muito baixas o intervalo pode passar de INT_MAX: a chegada fica alem de qualquer simulacao
+    double gap = log(trace_uniform(source)) / -rate;
+    source->cycle = gap < (double)INT_MAX - 1 - source->cycle ? source->cycle + 1 + (int)gap : INT_MAX;
+
+    double u = limit + trace_uniform(source) * (1.0 - limit);
+    double term = limit, cumulative = limit;
+    int k = 0;
+    while (u > cumulative && k < 1000) {
+        k++;
+        term *= rate / k;
+        cumulative += term;
+    }
+    return k > 0 ? k : 1;
+}
+
+int service_cycles(TraceSource *source) {
+    double mean = source->generator.mean_service;
+    switch (source->generator.service) {
+        case SERVICE_GEOMETRIC: {
+            if (mean <= 1.0) return 1;     //log(1 - 1/mean) seria -inf
+            double u = trace_uniform(source);
+            return 1 + (int)(log(u) / log(1.0 - 1.0 / mean));
+        }
+        case SERVICE_PARETO: {
+            //Minimo escolhido para que a media seja mean: x_m = mean * (alfa - 1) / alfa
+            double x = mean / 3.0 / pow(trace_uniform(source), 1.0 / 1.5);
+            return x > 1e6 ? 1000000 : x < 1.5 ? 1 : (int)(x + 0.5);
+        }
+        default: {
+            int span = (int)(2 * mean - 1 + 0.5);
+            return (int)(trace_random(source) % (span > 1 ? span : 1)) + 1;
+        }
+    }
+}
+
+//O relogio da fila e os ciclos das chegadas sao int
+int batch_cycles_ok(long cycles) {
+    return cycles >= 1 && cycles < INT_MAX;
+}
+
+//Parametros para os quais as distribuicoes acima estao definidas
+int generator_config_ok(GeneratorConfig config) {
+    return config.rate > 0 && config.mean_service >= 1 && config.interactive >= 0 && config.interactive <= 1;
+}
+
+TraceSource open_generator(GeneratorConfig config) {
+    TraceSource source;
+    memset(&source, 0, sizeof(source));
+    source.generator = config;
+    source.rng = 0x9E3779B97F4A7C15ULL ^ (config.seed << 1);
+    source.cycle = -1;
+    source.poisson_limit = exp(-config.rate);
+    return source;
+}
+
+//Retorna 0 se o arquivo nao puder ser aberto
+int open_trace_file(TraceSource *source, const char *name) {
+    memset(source, 0, sizeof(*source));
+    source->file = fopen(name, "r");
+    return source->file != NULL;
+}
+
+void close_trace(TraceSource *source) {
+    if (source->file != NULL) fclose(source->file);
+    source->file = NULL;
+}
+
+//Proxima chegada; retorna 0 no fim do trace ou em linha invalida (impressa em stderr)
+int next_arrival(TraceSource *source, Arrival *a) {
+    if (source->file != NULL) {
+        char line[256];
+        while (fgets(line, sizeof(line), source->file) != NULL) {
+            source->line++;
+            if (line[0] == '#' || line[0] == '\n' || line[0] == '\r') continue;
+            if (sscanf(line, "%d %d %d %c %d", &a->cycle, &a->id, &a->priority, &a->type, &a->required_cycles) != 5
+                || (a->type != 'i' && a->type != 'b') || a->required_cycles < 1) {
+                fprintf(stderr, "Linha %ld do trace invalida.\n", source->line);
+                source->error = 1;
+                return 0;
+            }
+            //Uma chegada fora de ordem entraria na fila atrasada, com a espera errada
+            if (a->cycle < source->last_cycle) {
+                fprintf(stderr, "Linha %ld do trace invalida: ciclo %d menor que o da linha anterior (%d).\n",
+                        source->line, a->cycle, source->last_cycle);
+                source->error = 1;
+                return 0;
+            }
+            source->last_cycle = a->cycle;
+            return 1;
+        }
+        return 0;
+    }
+
+    if (source->pending == 0) source->pending = poisson_next(source);
+    source->pending--;
+    a->cycle = source->cycle;
+    a->id = source->next_id++;
+    a->priority = trace_random(source) % 10 + 1;
+    a->type = trace_uniform(source) < source->generator.interactive ? 'i' : 'b';
+    a->required_cycles = service_cycles(source);
+    return 1;
+}
+
+//Grava as chegadas dos primeiros cycles ciclos do gerador no formato de arquivo de trace
+void write_trace(TraceSource *source, long cycles, FILE *out) {
+    Arrival a;
+    fprintf(out, "# ciclo id prioridade tipo ciclos_necessarios\n");
+    while (next_arrival(source, &a) && a.cycle < cycles) {
+        fprintf(out, "%d %d %d %c %d\n", a.cycle, a.id, a.priority, a.type, a.required_cycles);
+    }
+}
+
+
+/*
+    Metricas
+*/
+
+//Histograma de tempos de espera: percentis exatos com memoria proporcional a maior espera
+typedef struct {
+    long *count;
+    int capacity;
+    long total;
+    double sum;
+    int max;
+} WaitHistogram;
+
+void histogram_add(WaitHistogram *h, int wait) {
+    if (wait >= h->capacity) {
+        int capacity = h->capacity ? h->capacity : 1024;
+        while (capacity <= wait) capacity *= 2;
+        h->count = (long*)realloc(h->count, capacity * sizeof(long));
+        memset(h->count + h->capacity, 0, (capacity - h->capacity) * sizeof(long));
+        h->capacity = capacity;
+    }
+    h->count[wait]++;
+    h->total++;
+    h->sum += wait;
+    if (wait > h->max) h->max = wait;
+}
+
+//Menor espera w tal que pelo menos q% das esperas sao <= w
+int histogram_percentile(const WaitHistogram *h, double q) {
+    long target = (long)ceil(q / 100.0 * h->total);
+    long seen = 0;
+    for (int w = 0; w < h->capacity; w++) {
+        seen += h->count[w];
+        if (seen >= target && seen > 0) return w;
+    }
+    return 0;
+}
+
+/*
+    Assinatura do escalonamento: o cronograma e dividido em trechos maximos
+    (inicio, id, duracao) em que o mesmo processo executa em ciclos seguidos,
+    e cada trecho entra em um hash. Dois motores produzem o mesmo
+    escalonamento se e somente se (a menos de colisoes) os hashes coincidem,
+    nao importando se registram os ciclos um a um ou em blocos.
+*/
+typedef struct {
+    long start, length;
+    int id;
+    unsigned long long hash;
+} ScheduleHash;
+
+void schedule_flush(ScheduleHash *s) {
+    if (s->length == 0) return;
+    unsigned long long values[3] = {(unsigned long long)s->start, (unsigned long long)s->id,
+                                    (unsigned long long)s->length};
+    for (int i = 0; i < 3; i++) {
+        s->hash ^= values[i];
+        s->hash *= 0x100000001B3ULL;
+        s->hash ^= s->hash >> 29;
+    }
+    s->length = 0;
+}
+
+//O processo id executou nos ciclos cycle .. cycle + length - 1
+static inline void schedule_add(ScheduleHash *s, long cycle, int id, long length) {
+    if (s->length > 0 && s->id == id && s->start + s->length == cycle) {
+        s->length += length;
+        return;
+    }
+    schedule_flush(s);
+    s->start = cycle;
+    s->id = id;
+    s->length = length;
+}
+
+typedef struct {
+    long cycles;
+    long arrivals, rejected, completed, pending;
+    long busy_cycles;
+    long starved_completed, starved_pending;
+    long iterations;       //Passos do laco principal do motor
+    WaitHistogram waits;
+    ScheduleHash schedule;
+} BatchResult;
+
+
+/*
+    Execucao
+*/
+
+//Um ciclo do processo no topo; contabiliza espera e fome de quem termina
+static inline void batch_execute(PriorityQueue *queue, BatchResult *r, int starvation_limit) {
+    if (queue->size == 0) return;
+    schedule_add(&r->schedule, queue->clock, peek(queue)->id, 1);
+
+    Process finished;
+    int status = execute_cycle(queue, &finished);
+    r->busy_cycles++;
+    if (status == 2) {
+        int wait = queue->clock + 1 - finished.arrived_at - finished.required_cycles;
+        histogram_add(&r->waits, wait);
+        r->completed++;
+        if (wait > starvation_limit) r->starved_completed++;
+    }
+}
+
+//Insere as chegadas ate o ciclo atual; next guarda a primeira chegada ainda nao inserida
+static inline int batch_arrivals(PriorityQueue *queue, TraceSource *source, Arrival *next, int has_next,
+                                 BatchResult *r) {
+    while (has_next && next->cycle <= queue->clock) {
+        Process p = {next->id, next->priority, queue->clock, 0, next->required_cycles, queue->clock, next->type};
+        if (insert_process(queue, &p)) r->arrivals++;
+        else r->rejected++;
+        has_next = next_arrival(source, next);
+    }
+    return has_next;
+}
+
+//Fecha o resultado: processos ainda na fila que ja esperaram demais tambem passaram fome
+void batch_finish(PriorityQueue *queue, BatchResult *r, int starvation_limit) {
+    r->pending = queue->size;
+    for (int l = 0; l < 2; l++) {
+        for (int i = 0; i < queue->lanes[l].size; i++) {
+            Process *p = &queue->processes[queue->lanes[l].slots[i]];
+            if (queue->clock - p->arrived_at - p->executed_cycles > starvation_limit) r->starved_pending++;
+        }
+    }
+    schedule_flush(&r->schedule);
+}
+
+//Motor ciclo a ciclo, com as mesmas regras do laco de main()
+BatchResult run_batch(TraceSource *source, long cycles, int starvation_limit) {
+    BatchResult r;
+    memset(&r, 0, sizeof(r));
+    r.cycles = cycles;
+
+    PriorityQueue queue = create_priority_queue();
+    Arrival next;
+    int has_next = next_arrival(source, &next);
+
+    for (long cycle = 0; cycle < cycles; cycle++) {
+        has_next = batch_arrivals(&queue, source, &next, has_next, &r);
+        batch_execute(&queue, &r, starvation_limit);
+        aging(&queue);
+        r.iterations++;
+    }
+
+    batch_finish(&queue, &r, starvation_limit);
+    destroy_priority_queue(&queue);
+    return r;
+}
+
+void print_batch_header(FILE *out) {
+    fprintf(out, "engine,cycles,iterations,arrivals,rejected,completed,pending,throughput,utilization,"
+                 "wait_mean,wait_p50,wait_p99,wait_max,starved_completed,starved_pending,schedule_hash\n");
+}
+
+void print_batch_result(const char *engine, const BatchResult *r, FILE *out) {
+    fprintf(out, "%s,%ld,%ld,%ld,%ld,%ld,%ld,%.6f,%.6f,%.3f,%d,%d,%d,%ld,%ld,%016llx\n",
+            engine, r->cycles, r->iterations, r->arrivals, r->rejected, r->completed, r->pending,
+            (double)r->completed / r->cycles, (double)r->busy_cycles / r->cycles,
+            r->waits.total ? r->waits.sum / r->waits.total : 0.0,
+            histogram_percentile(&r->waits, 50), histogram_percentile(&r->waits, 99), r->waits.max,
+            r->starved_completed, r->starved_pending, r->schedule.hash);
+}
+
+#endif
@@ -0,0 +1,273 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "priority_queue.h"
+
+/*
+    Benchmark de insert/remove_max da fila de prioridade.
+
+    Compara quatro layouts:
+      aos-2:     heap binaria com o Process inteiro em cada posicao, trocado a
+                 cada passo do sift, sem indice (o layout original da fila)
+      aos-idx-2: o mesmo com indice id -> posicao em tabela hash, atualizado
+                 a cada movimento (o layout antes do crescimento dinamico)
+      soa-idx-2: heap binaria so com chaves + slots (priority_queue.h)
+      soa-idx-4: mesma coisa com heap 4-aria
+
+    As variantes com indice pagam pela busca por id, que a original nao tem.
+    Todos os processos sao interativos: as variantes AoS tem uma heap so, e
+    com um tipo so as SoA tambem usam uma unica lane do mesmo tamanho n, entao
+    a diferenca medida e so a do layout.
+
+    Uso: benchmark_heap [n_maximo]     (padrao 1000000; n = 10^3 .. n_maximo)
+    Saida (CSV): layout,n,insert_ns,remove_max_ns
+*/
+
+double now_ns(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+
+/*
+    Layout original, com crescimento dinamico para suportar os mesmos tamanhos
+*/
+
+typedef struct {
+    Process *heap;
+    int size, capacity;
+} AosQueue;
+
+void aos_swap(Process *a, Process *b) {
+    Process temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+void aos_insert(AosQueue *queue, Process p) {
+    if (queue->size == queue->capacity) {
+        queue->capacity = queue->capacity ? 2 * queue->capacity : 16;
+        queue->heap = (Process*)realloc(queue->heap, queue->capacity * sizeof(Process));
+    }
+    int i = queue->size++;
+    queue->heap[i] = p;
+    while (i != 0) {
+        int parent = (i - 1) / 2;
+        if (aging_key(&queue->heap[parent]) >= aging_key(&queue->heap[i])) break;
+        aos_swap(&queue->heap[i], &queue->heap[parent]);
+        i = parent;
+    }
+}
+
+Process aos_remove_max(AosQueue *queue) {
+    Process max = queue->heap[0];
+    queue->heap[0] = queue->heap[--queue->size];
+
+    int i = 0;
+    while (2 * i + 1 < queue->size) {
+        int largest = i;
+        int left = 2 * i + 1;
+        int right = 2 * i + 2;
+        if (aging_key(&queue->heap[left]) > aging_key(&queue->heap[largest])) largest = left;
+        if (right < queue->size && aging_key(&queue->heap[right]) > aging_key(&queue->heap[largest])) largest = right;
+        if (largest == i) break;
+        aos_swap(&queue->heap[i], &queue->heap[largest]);
+        i = largest;
+    }
+    return max;
+}
+
+
+/*
+    Layout anterior: Process inteiro na heap e indice id -> posicao em tabela
+    hash, atualizado a cada passo do sift
+*/
+
+typedef struct {
+    int id;
+    int pos;               //-1 indica entrada livre
+} AosIndexEntry;
+
+typedef struct {
+    AosQueue heap;
+    AosIndexEntry *index;
+    int index_capacity;
+} AosIndexedQueue;
+
+AosIndexEntry *aos_index_entry(AosIndexedQueue *queue, int id) {
+    unsigned int mask = (unsigned int)(queue->index_capacity - 1);
+    unsigned int i = index_hash(id, queue->index_capacity);
+    while (queue->index[i].pos != -1 && queue->index[i].id != id) i = (i + 1) & mask;
+    return &queue->index[i];
+}
+
+void aos_index_remove(AosIndexedQueue *queue, int id) {
+    unsigned int mask = (unsigned int)(queue->index_capacity - 1);
+    unsigned int i = (unsigned int)(aos_index_entry(queue, id) - queue->index);
+    queue->index[i].pos = -1;
+    unsigned int j = i;
+    for (;;) {
+        j = (j + 1) & mask;
+        if (queue->index[j].pos == -1) return;
+        unsigned int home = index_hash(queue->index[j].id, queue->index_capacity);
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            queue->index[i] = queue->index[j];
+            queue->index[j].pos = -1;
+            i = j;
+        }
+    }
+}
+
+static inline void aos_place(AosIndexedQueue *queue, int i, Process p) {
+    queue->heap.heap[i] = p;
+    AosIndexEntry *entry = aos_index_entry(queue, p.id);
+    entry->id = p.id;
+    entry->pos = i;
+}
+
+void aos_indexed_insert(AosIndexedQueue *queue, Process p) {
+    AosQueue *heap = &queue->heap;
+    if (heap->size == heap->capacity) {
+        heap->capacity = heap->capacity ? 2 * heap->capacity : 16;
+        heap->heap = (Process*)realloc(heap->heap, heap->capacity * sizeof(Process));
+    }
+    int i = heap->size++;
+    long long key = aging_key(&p);
+    while (i != 0) {
+        int parent = (i - 1) / 2;
+        if (aging_key(&heap->heap[parent]) >= key) break;
+        aos_place(queue, i, heap->heap[parent]);
+        i = parent;
+    }
+    aos_place(queue, i, p);
+}
+
+Process aos_indexed_remove_max(AosIndexedQueue *queue) {
+    AosQueue *heap = &queue->heap;
+    Process max = heap->heap[0];
+    aos_index_remove(queue, max.id);
+
+    Process p = heap->heap[--heap->size];
+    long long key = aging_key(&p);
+    int i = 0;
+    if (heap->size == 0) return max;
+    while (2 * i + 1 < heap->size) {
+        int child = 2 * i + 1;
+        if (child + 1 < heap->size && aging_key(&heap->heap[child + 1]) > aging_key(&heap->heap[child])) child++;
+        if (aging_key(&heap->heap[child]) <= key) break;
+        aos_place(queue, i, heap->heap[child]);
+        i = child;
+    }
+    aos_place(queue, i, p);
+    return max;
+}
+
+
+//Carga de trabalho: n insercoes (o relogio avanca a cada 4) seguidas de n remove_max, todas do tipo 'i'
+typedef struct {
+    int *priority;
+    int *required;
+} Workload;
+
+Workload make_workload(int n) {
+    Workload w;
+    w.priority = (int*)malloc(n * sizeof(int));
+    w.required = (int*)malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) {
+        w.priority[i] = rand() % 10 + 1;
+        w.required[i] = rand() % 5 + 1;
+    }
+    return w;
+}
+
+void run_aos(const Workload *w, int n, double *insert_ns, double *remove_ns) {
+    AosQueue queue = {NULL, 0, 0};
+    int sink = 0;
+
+    double start = now_ns();
+    for (int i = 0; i < n; i++) {
+        Process p = {i, w->priority[i], i / 4, 0, w->required[i], i / 4, 'i'};
+        aos_insert(&queue, p);
+    }
+    double middle = now_ns();
+    for (int i = 0; i < n; i++) sink += aos_remove_max(&queue).id;
+    double end = now_ns();
+
+    *insert_ns += middle - start;
+    *remove_ns += end - middle;
+    if (sink == 42) printf(" ");
+    free(queue.heap);
+}
+
+void run_aos_indexed(const Workload *w, int n, double *insert_ns, double *remove_ns) {
+    AosIndexedQueue queue = {{NULL, 0, 0}, NULL, 16};
+    while (queue.index_capacity < 2 * n) queue.index_capacity *= 2;
+    queue.index = (AosIndexEntry*)malloc(queue.index_capacity * sizeof(AosIndexEntry));
+    for (int i = 0; i < queue.index_capacity; i++) queue.index[i].pos = -1;
+    int sink = 0;
+
+    double start = now_ns();
+    for (int i = 0; i < n; i++) {
+        Process p = {i, w->priority[i], i / 4, 0, w->required[i], i / 4, 'i'};
+        aos_indexed_insert(&queue, p);
+    }
+    double middle = now_ns();
+    for (int i = 0; i < n; i++) sink += aos_indexed_remove_max(&queue).id;
+    double end = now_ns();
+
+    *insert_ns += middle - start;
+    *remove_ns += end - middle;
+    if (sink == 42) printf(" ");
+    free(queue.heap.heap);
+    free(queue.index);
+}
+
+void run_soa(const Workload *w, int n, int arity, double *insert_ns, double *remove_ns) {
+    PriorityQueue queue = create_priority_queue_arity(arity);
+    int sink = 0;
+
+    double start = now_ns();
+    for (int i = 0; i < n; i++) {
+        insert(&queue, i, w->priority[i], 'i', w->required[i]);
+        if (i % 4 == 3) aging(&queue);
+    }
+    double middle = now_ns();
+    for (int i = 0; i < n; i++) sink += remove_max(&queue).id;
+    double end = now_ns();
+
+    *insert_ns += middle - start;
+    *remove_ns += end - middle;
+    if (sink == 42) printf(" ");
+    destroy_priority_queue(&queue);
+}
+
+int main(int argc, char *argv[]) {
+    long max_n = argc > 1 ? atol(argv[1]) : 1000000;
+    srand(1);
+
+    printf("layout,n,insert_ns,remove_max_ns\n");
+    for (long n = 1000; n <= max_n; n *= 10) {
+        Workload w = make_workload((int)n);
+        //Repete os tamanhos pequenos para somar pelo menos ~10^6 operacoes
+        int reps = n >= 1000000 ? 1 : (int)(1000000 / n);
+
+        const char *names[] = {"aos-2", "aos-idx-2", "soa-idx-2", "soa-idx-4"};
+        for (int layout = 0; layout < 4; layout++) {
+            double insert_ns = 0, remove_ns = 0;
+            for (int r = 0; r < reps; r++) {
+                if (layout == 0) run_aos(&w, (int)n, &insert_ns, &remove_ns);
+                else if (layout == 1) run_aos_indexed(&w, (int)n, &insert_ns, &remove_ns);
+                else run_soa(&w, (int)n, layout == 2 ? 2 : 4, &insert_ns, &remove_ns);
+            }
+            printf("%s,%ld,%.1f,%.1f\n", names[layout],
+                   n, insert_ns / ((double)n * reps), remove_ns / ((double)n * reps));
+            fflush(stdout);
+        }
+
+        free(w.priority);
+        free(w.required);
+    }
+    return 0;
+}
@@ -0,0 +1,161 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "priority_queue.h"
+#include "submission.h"
+
+/*
+    Benchmark de submissao concorrente.
+
+    P threads produtoras submetem juntas n processos enquanto a thread do
+    escalonador repete drenar / executar um ciclo / aging. Compara:
+      mutex:    cada produtor trava a fila e chama insert() diretamente
+      mpsc-1:   buffer sem locks, um processo por no
+      mpsc-64:  buffer sem locks, lotes de 64 processos por no
+
+    O tempo vai do inicio ate o ultimo processo estar na heap.
+
+    Uso: benchmark_submission [n]     (padrao 2000000)
+    Saida (CSV): mode,producers,submissions,seconds,submissions_per_s,max_queue
+*/
+
+typedef enum { MODE_MUTEX, MODE_MPSC_SINGLE, MODE_MPSC_BATCH } Mode;
+
+typedef struct {
+    Mode mode;
+    PriorityQueue queue;
+    pthread_mutex_t lock;          //So no modo mutex
+    SubmissionBuffer buffer;
+    atomic_int producers_done;
+    atomic_int start;
+    int n_producers;
+    long per_producer;
+    int max_queue;
+    long inserted;
+} Bench;
+
+typedef struct {
+    Bench *bench;
+    int index;
+} ProducerArg;
+
+double now_seconds(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+void *producer_run(void *arg) {
+    ProducerArg *a = (ProducerArg*)arg;
+    Bench *bench = a->bench;
+    Producer producer = create_producer(&bench->buffer, bench->mode == MODE_MPSC_BATCH ? SUBMISSION_BATCH : 1);
+    unsigned int seed = (unsigned int)a->index * 2654435761u + 1;
+
+    while (!atomic_load(&bench->start)) sched_yield();
+
+    for (long i = 0; i < bench->per_producer; i++) {
+        int id = (int)(a->index * bench->per_producer + i);
+        seed = seed * 1103515245u + 12345u;
+        int priority = (int)(seed >> 16) % 10 + 1;
+        char type = (seed >> 8) & 1 ? 'i' : 'b';
+        int required_cycles = (int)(seed >> 20) % 5 + 1;
+
+        if (bench->mode == MODE_MUTEX) {
+            pthread_mutex_lock(&bench->lock);
+            insert(&bench->queue, id, priority, type, required_cycles);
+            pthread_mutex_unlock(&bench->lock);
+        } else {
+            submit(&producer, id, priority, type, required_cycles);
+        }
+    }
+    flush_submissions(&producer);
+    atomic_fetch_add(&bench->producers_done, 1);
+    return NULL;
+}
+
+//Laco do escalonador: ate todos os produtores terminarem e o buffer esvaziar
+void scheduler_run(Bench *bench) {
+    Process finished;
+    for (;;) {
+        int done = atomic_load(&bench->producers_done) == bench->n_producers;
+        int drained = 0;
+
+        if (bench->mode == MODE_MUTEX) pthread_mutex_lock(&bench->lock);
+        else drained = drain_submissions(&bench->buffer, &bench->queue);
+        bench->inserted += drained;
+        if (execute_cycle(&bench->queue, &finished) == 2 && bench->mode == MODE_MUTEX) bench->inserted++;
+        aging(&bench->queue);
+        if (bench->queue.size > bench->max_queue) bench->max_queue = bench->queue.size;
+        if (bench->mode == MODE_MUTEX) pthread_mutex_unlock(&bench->lock);
+
+        //done foi lido antes da drenagem, entao nada publicado antes dele ficou para tras
+        if (done) break;
+        if (drained == 0) sched_yield();
+    }
+}
+
+double run(Mode mode, int n_producers, long total, int *max_queue) {
+    Bench bench;
+    bench.mode = mode;
+    bench.queue = create_priority_queue();
+    pthread_mutex_init(&bench.lock, NULL);
+    init_submission_buffer(&bench.buffer);
+    atomic_init(&bench.producers_done, 0);
+    atomic_init(&bench.start, 0);
+    bench.n_producers = n_producers;
+    bench.per_producer = total / n_producers;
+    bench.max_queue = 0;
+    bench.inserted = 0;
+
+    pthread_t *threads = (pthread_t*)malloc(n_producers * sizeof(pthread_t));
+    ProducerArg *args = (ProducerArg*)malloc(n_producers * sizeof(ProducerArg));
+    for (int p = 0; p < n_producers; p++) {
+        args[p].bench = &bench;
+        args[p].index = p;
+        pthread_create(&threads[p], NULL, producer_run, &args[p]);
+    }
+
+    double start = now_seconds();
+    atomic_store(&bench.start, 1);
+    scheduler_run(&bench);
+    double elapsed = now_seconds() - start;
+
+    for (int p = 0; p < n_producers; p++) pthread_join(threads[p], NULL);
+    *max_queue = bench.max_queue;
+
+    //Confere que nenhum processo se perdeu: no modo mutex conta os concluidos mais os que sobraram
+    if (mode == MODE_MUTEX) bench.inserted += bench.queue.size;
+    if (bench.inserted != total || bench.buffer.rejected != 0) {
+        fprintf(stderr, "Erro: %ld processos submetidos, %ld chegaram a fila.\n", total, bench.inserted);
+        exit(1);
+    }
+
+    destroy_submission_buffer(&bench.buffer);
+    destroy_priority_queue(&bench.queue);
+    pthread_mutex_destroy(&bench.lock);
+    free(threads);
+    free(args);
+    return elapsed;
+}
+
+int main(int argc, char *argv[]) {
+    long total = argc > 1 ? atol(argv[1]) : 2000000;
+    const char *names[] = {"mutex", "mpsc-1", "mpsc-64"};
+
+    printf("mode,producers,submissions,seconds,submissions_per_s,max_queue\n");
+    for (int n_producers = 1; n_producers <= 64; n_producers *= 2) {
+        long submissions = total / n_producers * n_producers;
+        for (int mode = 0; mode < 3; mode++) {
+            int max_queue;
+            double seconds = run((Mode)mode, n_producers, submissions, &max_queue);
+            printf("%s,%d,%ld,%.4f,%.0f,%d\n", names[mode], n_producers, submissions, seconds,
+                   submissions / seconds, max_queue);
+            fflush(stdout);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,180 @@
+#ifndef EVENTS_H
+#define EVENTS_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <limits.h>
+#include "priority_queue.h"
+#include "batch.h"
+
+/*
+    Motor por eventos
+
+    O laco ciclo a ciclo gasta uma iteracao por ciclo mesmo quando nada muda.
+    Aqui o motor salta direto para o proximo ciclo em que o escalonamento pode
+    mudar, que e o mais cedo entre:
+      - a proxima chegada
+      - o ciclo em que o processo em execucao fica a um ciclo do fim (a partir
+        dai vale o aumento de prioridade de execute_cycle() e depois o termino)
+      - o ciclo em que o topo da outra heap passa a vencer pelo aging: a
+        ordem dentro de cada heap nao muda com o tempo, so a comparacao entre
+        os dois topos (ver cycles_until_switch)
+    Como sao sempre tres candidatos, a fila de eventos se reduz a um minimo.
+    Entre dois eventos o mesmo processo executa todos os ciclos, entao o salto
+    so soma executed_cycles e o relogio. Com a fila vazia o motor salta ate a
+    proxima chegada. Perto de um evento (salto de 1 ciclo) ele executa um
+    ciclo normal com execute_cycle(), o que garante as mesmas regras do laco
+    ciclo a ciclo.
+*/
+
+//Prioridade efetiva do topo interativo menos a do topo background daqui a j ciclos
+static inline long top_gap(const PriorityQueue *queue, const Process *interactive, const Process *background,
+                           long j) {
+    long clock = queue->clock + j;
+    return (interactive->priority + (clock - interactive->enqueued_at) / AGING_INTERACTIVE)
+         - (background->priority + (clock - background->enqueued_at) / AGING_BACKGROUND);
+}
+
+/*
+    Ciclos ate a heap vencedora deixar de ser lane, se nada mais acontecer;
+    LONG_MAX se isso nunca ocorrer. A cada W = periodo_i * periodo_b ciclos a
+    diferenca entre os topos volta ao mesmo padrao somada de periodo_b -
+    periodo_i, entao basta examinar uma janela e saltar as janelas inteiras.
+*/
+long cycles_until_switch(const PriorityQueue *queue, int lane) {
+    const long window = (long)AGING_INTERACTIVE * AGING_BACKGROUND;
+    const Process *interactive = lane_top(queue, 0), *background = lane_top(queue, 1);
+
+    //f(j) < 0 exatamente quando a outra heap vence no ciclo j (interativos vencem empates)
+    long drift = lane == 0 ? AGING_BACKGROUND - AGING_INTERACTIVE : AGING_INTERACTIVE - AGING_BACKGROUND;
+    long lowest = LONG_MAX;
+    for (long j = 1; j <= window; j++) {
+        long gap = top_gap(queue, interactive, background, j);
+        long f = lane == 0 ? gap : -gap - 1;
+        if (f < 0) return j;
+        if (f < lowest) lowest = f;
+    }
+    if (drift >= 0) return LONG_MAX;
+
+    //Primeira janela em que o minimo fica negativo
+    long k = lowest / -drift + 1;
+    for (long j = 1; j <= window; j++) {
+        long gap = top_gap(queue, interactive, background, j);
+        if ((lane == 0 ? gap : -gap - 1) + k * drift < 0) return k * window + j;
+    }
+    return LONG_MAX;
+}
+
+BatchResult run_batch_events(TraceSource *source, long cycles, int starvation_limit) {
+    BatchResult r;
+    memset(&r, 0, sizeof(r));
+    r.cycles = cycles;
+
+    PriorityQueue queue = create_priority_queue();
+    Arrival next;
+    int has_next = next_arrival(source, &next);
+
+    while (queue.clock < cycles) {
+        has_next = batch_arrivals(&queue, source, &next, has_next, &r);
+        r.iterations++;
+
+        long horizon = cycles - queue.clock;
+        if (has_next && next.cycle - queue.clock < horizon) horizon = next.cycle - queue.clock;
+
+        if (queue.size == 0) {
+            queue.clock += (int)horizon;
+            continue;
+        }
+
+        int lane = max_lane(&queue);
+        Process *p = lane_top(&queue, lane);
+        long run = p->required_cycles - p->executed_cycles - 2;
+        if (run > 1 && queue.lanes[1 - lane].size > 0) {
+            long until_switch = cycles_until_switch(&queue, lane);
+            if (until_switch < run) run = until_switch;
+        }
+        if (horizon < run) run = horizon;
+
+        if (run <= 1) {
+            batch_execute(&queue, &r, starvation_limit);
+            aging(&queue);
+            continue;
+        }
+
+        schedule_add(&r.schedule, queue.clock, p->id, run);
+        p->executed_cycles += (int)run;
+        r.busy_cycles += run;
+        queue.clock += (int)run;
+    }
+
+    batch_finish(&queue, &r, starvation_limit);
+    destroy_priority_queue(&queue);
+    return r;
+}
+
+
+/*
+    Validacao: os dois motores precisam produzir o mesmo escalonamento e as
+    mesmas metricas em traces aleatorios
+*/
+
+int same_result(const BatchResult *a, const BatchResult *b) {
+    return a->arrivals == b->arrivals && a->rejected == b->rejected && a->completed == b->completed
+        && a->pending == b->pending && a->busy_cycles == b->busy_cycles
+        && a->starved_completed == b->starved_completed && a->starved_pending == b->starved_pending
+        && a->waits.total == b->waits.total && a->waits.sum == b->waits.sum && a->waits.max == b->waits.max
+        && a->schedule.hash == b->schedule.hash;
+}
+
+double elapsed_seconds(clock_t start) {
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+//Roda n_traces traces gerados com parametros variados; retorna o numero de divergencias
+int validate_engines(int n_traces, long cycles, int starvation_limit) {
+    int mismatches = 0;
+    long tick_iterations = 0, event_iterations = 0;
+    double tick_time = 0, event_time = 0;
+
+    printf("trace,rate,service,mean,interactive,tick_iterations,event_iterations,equal\n");
+    for (int t = 1; t <= n_traces; t++) {
+        //Parametros sorteados a partir de uma fonte propria, para cobrir cargas baixas, altas e sobrecarga
+        TraceSource dice = open_generator((GeneratorConfig){1.0, 1.0, SERVICE_UNIFORM, 0.5, 1000 + t});
+        GeneratorConfig config;
+        config.service = (ServiceDistribution)(t % 3);
+        config.mean_service = 1 + trace_random(&dice) % 40;
+        config.rate = (0.2 + 1.0 * trace_uniform(&dice)) / config.mean_service;
+        config.interactive = trace_uniform(&dice);
+        config.seed = t;
+
+        TraceSource source = open_generator(config);
+        clock_t start = clock();
+        BatchResult tick = run_batch(&source, cycles, starvation_limit);
+        tick_time += elapsed_seconds(start);
+
+        source = open_generator(config);
+        start = clock();
+        BatchResult events = run_batch_events(&source, cycles, starvation_limit);
+        event_time += elapsed_seconds(start);
+
+        int equal = same_result(&tick, &events);
+        if (!equal) mismatches++;
+        tick_iterations += tick.iterations;
+        event_iterations += events.iterations;
+
+        printf("%d,%.4f,%s,%.0f,%.2f,%ld,%ld,%s\n", t, config.rate,
+               config.service == SERVICE_UNIFORM ? "uniform" : config.service == SERVICE_GEOMETRIC ? "geometric" : "pareto",
+               config.mean_service, config.interactive, tick.iterations, events.iterations, equal ? "sim" : "nao");
+        free(tick.waits.count);
+        free(events.waits.count);
+    }
+
+    fprintf(stderr, "%d traces, %d divergencias | iteracoes: %ld ciclo a ciclo, %ld por eventos | "
+                    "tempo: %.2fs ciclo a ciclo, %.2fs por eventos\n",
+            n_traces, mismatches, tick_iterations, event_iterations, tick_time, event_time);
+    return mismatches;
+}
+
+#endif
@@ -1,140 +1,53 @@
 #include <stdio.h>
 #include <stdlib.h>
-
-#define MAX 1000
-
-typedef struct {
-    int id;
-    int priority;
-    int wait_cycles;      
-    int executed_cycles;   
-    int required_cycles;   
-    char type;           
-} Process;
-
-typedef struct {
-    Process heap[MAX];
-    int size;
-} PriorityQueue;
-
-PriorityQueue create_priority_queue() {
-    PriorityQueue queue;
-    queue.size = 0;
-    return queue;
-}
-
-void swap(Process *a, Process *b) {
-    Process temp = *a;
-    *a = *b;
-    *b = temp;
-}
-
-void insert(PriorityQueue *queue, int id, int priority, char type, int required_cycles) {
-    int i = queue->size;
-
-    queue->heap[i].id = id;
-    queue->heap[i].priority = priority;
-    queue->heap[i].wait_cycles = 0;
-    queue->heap[i].executed_cycles = 0;
-    queue->heap[i].required_cycles = required_cycles;
-    queue->heap[i].type = type;
-
-    while (i != 0) {
-        int parent = (i - 1) / 2;
-
-        if (queue->heap[parent].priority > queue->heap[i].priority) break;
-
-        if (queue->heap[parent].priority == queue->heap[i].priority &&
-            queue->heap[parent].type == 'i') break;
-
-        swap(&queue->heap[i], &queue->heap[parent]);
-        i = parent;
-    }
-    queue->size++;
-}
-
-Process remove_max(PriorityQueue *queue) {
-    Process max = queue->heap[0];
-    queue->heap[0] = queue->heap[--queue->size];
-
-    int i = 0;
-    while (2 * i + 1 < queue->size) {
-        int largest = i;
-        int left = 2 * i + 1;
-        int right = 2 * i + 2;
-
-        if (queue->heap[left].priority > queue->heap[largest].priority ||
-            (queue->heap[left].priority == queue->heap[largest].priority && 
-             queue->heap[left].type == 'i' && queue->heap[largest].type != 'i')) {
-            largest = left;
-        }
-
-        if (right < queue->size && 
-            (queue->heap[right].priority > queue->heap[largest].priority ||
-             (queue->heap[right].priority == queue->heap[largest].priority && 
-              queue->heap[right].type == 'i' && queue->heap[largest].type != 'i'))) {
-            largest = right;
-        }
-
-        if (largest == i) break;
-
-        swap(&queue->heap[i], &queue->heap[largest]);
-        i = largest;
-    }
-    return max;
-}
-
-void aging(PriorityQueue *queue) {
-    for (int i = 0; i < queue->size; i++) {
-        queue->heap[i].wait_cycles++;
-
-        if (queue->heap[i].type == 'i' && queue->heap[i].wait_cycles >= 2) {
-            queue->heap[i].priority++;
-            queue->heap[i].wait_cycles = 0;
-        } 
-        else if (queue->heap[i].type == 'b' && queue->heap[i].wait_cycles >= 5) {
-            queue->heap[i].priority++;
-            queue->heap[i].wait_cycles = 0;
-        }
-    }
-}
+#include <string.h>
+#include "priority_queue.h"
+#include "multicore.h"
+#include "batch.h"
+#include "events.h"
 
 void print_queue(PriorityQueue *queue) {
     printf("\n--- Estado Atual da Fila de Prioridade: ---\n");
-    for (int i = 0; i < queue->size; i++) {
-        printf("ID: %d | Prioridade: %d | Tipo: %s | Ciclos em espera: %d | Executado: %d/%d\n",
-               queue->heap[i].id,
-               queue->heap[i].priority,
-               queue->heap[i].type == 'i' ? "Interativo" : "Background",
-               queue->heap[i].wait_cycles,
-               queue->heap[i].executed_cycles,
-               queue->heap[i].required_cycles);
+    for (int l = 0; l < 2; l++) {
+        Heap *heap = &queue->lanes[l];
+        for (int i = 0; i < heap->size; i++) {
+            Process *p = &queue->processes[heap->slots[i]];
+            printf("ID: %d | Prioridade: %d | Tipo: %s | Ciclos em espera: %d | Executado: %d/%d\n",
+                   p->id,
+                   effective_priority(queue, p),
+                   p->type == 'i' ? "Interativo" : "Background",
+                   wait_cycles(queue, p),
+                   p->executed_cycles,
+                   p->required_cycles);
+        }
     }
     printf("-------------------------------------\n");
 }
 
 void execute_process(PriorityQueue *queue) {
-    if (queue->size == 0) return;
+    Process *p = peek(queue);
+    if (p == NULL) return;
 
-    Process *p = &queue->heap[0];
     p->executed_cycles++;
 
+    int priority = effective_priority(queue, p);
     printf("\n Executando Processo ID #%d | Prioridade: %d | Ciclo %d/%d\n",
-           p->id, p->priority, p->executed_cycles, p->required_cycles);
+           p->id, priority, p->executed_cycles, p->required_cycles);
 
     if (p->required_cycles - p->executed_cycles <= 1) {
-        if (p->type == 'i' && p->priority < 10) {
+        if (p->type == 'i' && priority < 10) {
             printf("Processo Interativo ID #%d prestes a finalizar! Prioridade elevada para 10.\n", p->id);
-            p->priority = 10;
-        } else if (p->type == 'b' && p->priority < 9) {
+            change_priority(queue, p->id, 10);
+        } else if (p->type == 'b' && priority < 9) {
             printf("Processo Background ID #%d prestes a finalizar! Prioridade elevada para 9.\n", p->id);
-            p->priority = 9;
+            change_priority(queue, p->id, 9);
         }
     }
 
+    //O processo fica no mesmo slot mesmo que change_priority o mova na heap
     if (p->executed_cycles >= p->required_cycles) {
         printf("Processo ID #%d concluido e removido da fila.\n", p->id);
-        remove_max(queue);
+        remove_by_id(queue, p->id, NULL);
     }
 }
 void generate_new_process(PriorityQueue *queue, int cycles) {
@@ -148,11 +61,128 @@ void generate_new_process(PriorityQueue *queue, int cycles) {
     printf("\n Novo processo chegou! (ID #%d, Prioridade: %d, Ciclos necessarios: %d)\n",
            new_id, new_priority, required_cycles);
 
-    insert(queue, new_id, new_priority, type, required_cycles);
+    if (!insert(queue, new_id, new_priority, type, required_cycles)) {
+        printf("Processo ID #%d rejeitado: ID repetido.\n", new_id);
+    }
 }
 
 
-int main() {
+//Modo em lote: reproduz o trace (ou so o grava, com --write-trace) e imprime o resumo em CSV
+int run_batch_mode(const char *trace_file, GeneratorConfig generator, long cycles, int starvation_limit,
+                   int use_events, const char *csv_file, const char *write_trace_file) {
+    TraceSource source;
+    if (trace_file != NULL) {
+        if (!open_trace_file(&source, trace_file)) {
+            printf("Erro ao abrir o trace %s.\n", trace_file);
+            return 1;
+        }
+    } else {
+        source = open_generator(generator);
+    }
+
+    const char *name = write_trace_file != NULL ? write_trace_file : csv_file;
+    FILE *out = stdout;
+    if (name != NULL && (out = fopen(name, "w")) == NULL) {
+        printf("Erro ao abrir o arquivo %s para escrita.\n", name);
+        close_trace(&source);
+        return 1;
+    }
+
+    if (write_trace_file != NULL) {
+        write_trace(&source, cycles, out);
+    } else {
+        BatchResult r = use_events ? run_batch_events(&source, cycles, starvation_limit)
+                                   : run_batch(&source, cycles, starvation_limit);
+        print_batch_header(out);
+        print_batch_result(use_events ? "events" : "tick", &r, out);
+        free(r.waits.count);
+    }
+
+    if (out != stdout) fclose(out);
+    close_trace(&source);
+    return source.error;
+}
+
+/*
+    Uso: main                                   simulacao de um nucleo, ciclo a ciclo
+         main --cores N [--cycles C] [--load L] [--seed S] [--no-steal]
+                                                N nucleos em threads, com relatorio final
+         main --batch [--trace ARQ | --rate R --service uniform|geometric|pareto --mean M
+                      --interactive F --seed S] [--cycles C] [--starvation T]
+                      [--engine tick|events] [--csv ARQ | --write-trace ARQ]
+                                                um nucleo sem saida por ciclo, resumo em CSV
+         main --validate N [--cycles C]         compara os dois motores do modo em lote em N traces
+*/
+int main(int argc, char *argv[]) {
+    int n_cores = 0, batch = 0, starvation_limit = 100, use_events = 0, validate = 0;
+    long cycles_option = 0;
+    MulticoreConfig config = {100000, 0.9, 1, 1};
+    GeneratorConfig generator = {0.3, 3.0, SERVICE_UNIFORM, 0.5, 1};
+    const char *trace_file = NULL, *csv_file = NULL, *write_trace_file = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--cores") == 0 && i + 1 < argc) n_cores = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--cycles") == 0 && i + 1 < argc) cycles_option = atol(argv[++i]);
+        else if (strcmp(argv[i], "--load") == 0 && i + 1 < argc) config.load = atof(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) config.seed = generator.seed = (unsigned int)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--no-steal") == 0) config.steal = 0;
+        else if (strcmp(argv[i], "--batch") == 0) batch = 1;
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) trace_file = argv[++i];
+        else if (strcmp(argv[i], "--rate") == 0 && i + 1 < argc) generator.rate = atof(argv[++i]);
+        else if (strcmp(argv[i], "--mean") == 0 && i + 1 < argc) generator.mean_service = atof(argv[++i]);
+        else if (strcmp(argv[i], "--interactive") == 0 && i + 1 < argc) generator.interactive = atof(argv[++i]);
+        else if (strcmp(argv[i], "--starvation") == 0 && i + 1 < argc) starvation_limit = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) csv_file = argv[++i];
+        else if (strcmp(argv[i], "--write-trace") == 0 && i + 1 < argc) write_trace_file = argv[++i];
+        else if (strcmp(argv[i], "--validate") == 0 && i + 1 < argc) validate = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--engine") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "tick") == 0) use_events = 0;
+            else if (strcmp(argv[i], "events") == 0) use_events = 1;
+            else {
+                printf("Motor invalido: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--service") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "uniform") == 0) generator.service = SERVICE_UNIFORM;
+            else if (strcmp(argv[i], "geometric") == 0) generator.service = SERVICE_GEOMETRIC;
+            else if (strcmp(argv[i], "pareto") == 0) generator.service = SERVICE_PARETO;
+            else {
+                printf("Distribuicao invalida: %s\n", argv[i]);
+                return 1;
+            }
+        } else {
+            printf("Opcao invalida: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if ((validate > 0 || batch) && cycles_option > 0 && !batch_cycles_ok(cycles_option)) {
+        printf("Parametros invalidos: --cycles deve ser menor que %d.\n", INT_MAX);
+        return 1;
+    }
+    if (validate > 0) {
+        return validate_engines(validate, cycles_option > 0 ? cycles_option : 200000, starvation_limit) > 0;
+    }
+    if (batch) {
+        if (trace_file == NULL && !generator_config_ok(generator)) {
+            printf("Parametros invalidos: --rate > 0, --mean >= 1 e --interactive entre 0 e 1.\n");
+            return 1;
+        }
+        return run_batch_mode(trace_file, generator, cycles_option > 0 ? cycles_option : 1000000,
+                              starvation_limit, use_events, csv_file, write_trace_file);
+    }
+    if (n_cores > 0) {
+        if (cycles_option > 0) config.cycles = cycles_option;
+        if (!multicore_limits_ok(n_cores, config.cycles)) {
+            printf("Parametros invalidos: ciclos * nucleos deve caber em %d.\n", INT_MAX);
+            return 1;
+        }
+        run_multicore(n_cores, config);
+        return 0;
+    }
+
     PriorityQueue queue = create_priority_queue();
     int cycles = 0;
 
@@ -175,5 +205,6 @@ int main() {
     }
 
     printf("\nTodos os processos foram concluidos.\n");
+    destroy_priority_queue(&queue);
     return 0;
 }
\ No newline at end of file
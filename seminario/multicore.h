@@ -0,0 +1,244 @@
+#ifndef MULTICORE_H
+#define MULTICORE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <pthread.h>
+#include "priority_queue.h"
+
+/*
+    Simulacao com varios nucleos
+
+    Cada nucleo simulado roda em uma thread propria e tem sua propria fila de
+    prioridade, com as mesmas regras de prioridade e aging da simulacao de um
+    nucleo. Cada ciclo tem tres fases separadas por barreiras:
+      1. cada nucleo recebe as chegadas do ciclo na sua fila
+      2. roubos (work stealing): cada nucleo com a fila vazia, em ordem de
+         indice a partir de um nucleo que gira a cada ciclo, rouba o
+         processo de maior prioridade de um nucleo que tenha pelo menos
+         dois processos
+      3. cada nucleo executa um ciclo do processo no topo e avanca o relogio
+         da sua fila
+
+    Os roubos sao feitos por uma so thread enquanto as outras esperam na
+    barreira: nenhuma fila muda ao mesmo tempo, a ordem dos roubos nao
+    depende do escalonamento das threads (a simulacao e reprodutivel para uma
+    mesma semente) e todos os relogios sao iguais, entao o enqueued_at do
+    processo roubado vale sem ajuste na fila do ladrao.
+
+    Os ids sao unicos enquanto chegadas * nucleos couber em um int, o que e
+    garantido por ciclos * nucleos <= INT_MAX (ver multicore_limits_ok).
+
+    Tempo de espera de um processo: ciclos entre a chegada e o fim em que ele
+    estava na fila sem executar.
+*/
+
+typedef struct {
+    long cycles;           //Ciclos simulados
+    double load;           //Utilizacao media alvo (chegadas * ciclos medios / nucleos)
+    int steal;             //0 desliga o roubo de trabalho
+    unsigned int seed;
+} MulticoreConfig;
+
+typedef struct {
+    PriorityQueue queue;
+    pthread_t thread;
+    unsigned long long rng;
+    int index;
+
+    long busy_cycles, arrivals, completed, steals;
+    int *waits;            //Tempo de espera de cada processo concluido
+    int n_waits, waits_capacity;
+
+    struct Multicore *system;
+} Core;
+
+typedef struct Multicore {
+    Core *cores;
+    int n_cores;
+    MulticoreConfig config;
+    pthread_barrier_t barrier;
+} Multicore;
+
+
+//xorshift64*: cada nucleo tem seu proprio gerador, sem disputar o rand()
+unsigned int core_random(Core *core) {
+    core->rng ^= core->rng >> 12;
+    core->rng ^= core->rng << 25;
+    core->rng ^= core->rng >> 27;
+    return (unsigned int)((core->rng * 2685821657736338717ULL) >> 32);
+}
+
+void record_wait(Core *core, int wait) {
+    if (core->n_waits == core->waits_capacity) {
+        core->waits_capacity = core->waits_capacity ? 2 * core->waits_capacity : 1024;
+        core->waits = (int*)realloc(core->waits, core->waits_capacity * sizeof(int));
+    }
+    core->waits[core->n_waits++] = wait;
+}
+
+//Chegadas de Bernoulli: probabilidade load / 3 por ciclo, ja que cada processo pede 3 ciclos em media
+void core_arrivals(Core *core) {
+    double p = core->system->config.load / 3.0;
+    if (core_random(core) >= p * 4294967296.0) return;
+
+    //Ids unicos entre os nucleos: o contador local intercalado pelo indice do nucleo
+    int id = (int)(core->arrivals * core->system->n_cores + core->index);
+    int priority = core_random(core) % 10 + 1;
+    char type = (core_random(core) % 2 == 0) ? 'i' : 'b';
+    int required_cycles = core_random(core) % 5 + 1;
+
+    insert(&core->queue, id, priority, type, required_cycles);
+    core->arrivals++;
+}
+
+//Tenta roubar um processo de outro nucleo; retorna 1 se conseguiu. So roda na fase de roubos
+int core_steal(Core *core) {
+    Multicore *system = core->system;
+    int start = core_random(core) % system->n_cores;
+
+    for (int k = 0; k < system->n_cores; k++) {
+        Core *victim = &system->cores[(start + k) % system->n_cores];
+        if (victim == core || victim->queue.size < 2) continue;
+
+        //Mesmo relogio nas duas filas: o credito de espera e mantido
+        Process p = remove_max(&victim->queue);
+        insert_process(&core->queue, &p);
+        core->steals++;
+        return 1;
+    }
+    return 0;
+}
+
+void steal_round(Multicore *system, long cycle) {
+    for (int k = 0; k < system->n_cores; k++) {
+        Core *core = &system->cores[(cycle + k) % system->n_cores];
+        if (core->queue.size == 0) core_steal(core);
+    }
+}
+
+void *core_run(void *arg) {
+    Core *core = (Core*)arg;
+    Multicore *system = core->system;
+
+    for (long cycle = 0; cycle < system->config.cycles; cycle++) {
+        core_arrivals(core);
+
+        //A thread liberada como serial faz os roubos; as outras esperam na segunda barreira
+        if (pthread_barrier_wait(&system->barrier) == PTHREAD_BARRIER_SERIAL_THREAD && system->config.steal)
+            steal_round(system, cycle);
+        pthread_barrier_wait(&system->barrier);
+
+        Process finished;
+        int status = execute_cycle(&core->queue, &finished);
+        if (status != 0) core->busy_cycles++;
+        if (status == 2) {
+            core->completed++;
+            //O processo executou neste ciclo (clock), entao terminou em clock + 1
+            record_wait(core, core->queue.clock + 1 - finished.arrived_at - finished.required_cycles);
+        }
+        //Sem barreira aqui: as chegadas do proximo ciclo so mexem na propria fila
+        aging(&core->queue);
+    }
+    return NULL;
+}
+
+//Os ids (chegadas * nucleos + indice) e os relogios das filas sao int
+int multicore_limits_ok(int n_cores, long cycles) {
+    return n_cores >= 1 && cycles >= 1 && cycles <= INT_MAX / n_cores;
+}
+
+
+/*
+    Relatorio
+*/
+
+int compare_int(const void *a, const void *b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+//Percentil q (0..100) de um vetor ordenado
+int percentile(const int *sorted, int n, double q) {
+    if (n == 0) return 0;
+    int i = (int)(q / 100.0 * (n - 1) + 0.5);
+    return sorted[i];
+}
+
+void print_multicore_report(Multicore *system) {
+    long cycles = system->config.cycles;
+    long total_waits = 0, total_busy = 0, total_completed = 0, total_pending = 0;
+
+    printf("\nNucleo | Utilizacao | Chegadas | Concluidos | Roubos | Pendentes | Espera p50/p90/p99\n");
+    for (int c = 0; c < system->n_cores; c++) {
+        Core *core = &system->cores[c];
+        qsort(core->waits, core->n_waits, sizeof(int), compare_int);
+        printf("%6d | %9.1f%% | %8ld | %10ld | %6ld | %9d | %d/%d/%d\n",
+               c, 100.0 * core->busy_cycles / cycles, core->arrivals, core->completed, core->steals,
+               core->queue.size,
+               percentile(core->waits, core->n_waits, 50),
+               percentile(core->waits, core->n_waits, 90),
+               percentile(core->waits, core->n_waits, 99));
+        total_waits += core->n_waits;
+        total_busy += core->busy_cycles;
+        total_completed += core->completed;
+        total_pending += core->queue.size;
+    }
+
+    int *all = (int*)malloc((total_waits > 0 ? total_waits : 1) * sizeof(int));
+    long n = 0;
+    for (int c = 0; c < system->n_cores; c++) {
+        for (int i = 0; i < system->cores[c].n_waits; i++) all[n++] = system->cores[c].waits[i];
+    }
+    qsort(all, n, sizeof(int), compare_int);
+
+    printf("\nTotal: utilizacao %.1f%% | %ld concluidos | %ld pendentes\n",
+           100.0 * total_busy / ((double)cycles * system->n_cores), total_completed, total_pending);
+    printf("Espera (ciclos): p50 %d | p90 %d | p99 %d | max %d\n",
+           percentile(all, (int)n, 50), percentile(all, (int)n, 90), percentile(all, (int)n, 99),
+           n > 0 ? all[n - 1] : 0);
+    free(all);
+}
+
+
+/*
+    Execucao
+*/
+
+void run_multicore(int n_cores, MulticoreConfig config) {
+    Multicore system;
+    system.n_cores = n_cores;
+    system.config = config;
+    system.cores = (Core*)calloc(n_cores, sizeof(Core));
+    pthread_barrier_init(&system.barrier, NULL, n_cores);
+
+    for (int c = 0; c < n_cores; c++) {
+        Core *core = &system.cores[c];
+        core->queue = create_priority_queue();
+        core->rng = 0x9E3779B97F4A7C15ULL ^ ((unsigned long long)config.seed << 16) ^ (unsigned long long)(c + 1);
+        core->index = c;
+        core->system = &system;
+    }
+
+    printf("Simulando %d nucleos por %ld ciclos (carga %.2f, roubo de trabalho %s)...\n",
+           n_cores, config.cycles, config.load, config.steal ? "ligado" : "desligado");
+
+    for (int c = 0; c < n_cores; c++) {
+        pthread_create(&system.cores[c].thread, NULL, core_run, &system.cores[c]);
+    }
+    for (int c = 0; c < n_cores; c++) {
+        pthread_join(system.cores[c].thread, NULL);
+    }
+
+    print_multicore_report(&system);
+
+    for (int c = 0; c < n_cores; c++) {
+        destroy_priority_queue(&system.cores[c].queue);
+        free(system.cores[c].waits);
+    }
+    pthread_barrier_destroy(&system.barrier);
+    free(system.cores);
+}
+
+#endif
@@ -0,0 +1,422 @@
+#ifndef PRIORITY_QUEUE_H
+#define PRIORITY_QUEUE_H
+
+#include <stdio.h>
+#include <stdlib.h>
+
+//Ciclos de espera para ganhar +1 de prioridade, por tipo de processo
+#define AGING_INTERACTIVE 2
+#define AGING_BACKGROUND 5
+
+//Aridade padrao das heaps: uma potencia de 2 (os indices de pai e filhos usam deslocamentos)
+#ifndef HEAP_ARITY
+#define HEAP_ARITY 4
+#endif
+#if HEAP_ARITY < 2 || (HEAP_ARITY & (HEAP_ARITY - 1)) != 0
+#error "HEAP_ARITY deve ser uma potencia de 2 (2, 4, 8, ...)"
+#endif
+
+typedef struct {
+    int id;
+    int priority;          //Prioridade base; a efetiva soma o credito de espera
+    int enqueued_at;       //Ciclo a partir do qual o credito de espera e contado
+    int executed_cycles;
+    int required_cycles;
+    int arrived_at;        //Ciclo de chegada, usado nas metricas de espera
+    char type;
+} Process;
+
+/*
+    O aging e calculado de forma preguicosa: em vez de percorrer a fila a cada
+    ciclo, cada processo guarda o ciclo em que entrou e sua prioridade efetiva e
+    priority + (clock - enqueued_at) / periodo do tipo.
+
+    Como interativos e background envelhecem em ritmos diferentes, cada tipo
+    tem sua propria heap. Dentro de uma heap a ordem entre dois processos nunca
+    muda com o tempo (a chave priority * periodo - enqueued_at e fixa), entao a
+    heap continua valida sem nenhuma atualizacao; aging() so avanca o relogio.
+
+    Layout: as heaps guardam apenas a chave (um long long, a unica coisa lida
+    nas comparacoes) e o numero do slot do processo, em vetores separados. Os
+    processos ficam em slots estaveis que nao se movem durante o sift, entao
+    cada passo copia 12 bytes em vez do Process inteiro. Todos os vetores
+    crescem sob demanda e as heaps podem ser binarias ou 4-arias.
+
+    Ponteiros devolvidos por peek() e find_process() continuam validos ate a
+    proxima insercao (que pode realocar os slots).
+*/
+typedef struct {
+    long long *keys;       //Chave de cada posicao da heap
+    int *slots;            //Slot do processo em cada posicao
+    int size, capacity;
+} Heap;
+
+/*
+    Indice id -> slot (tabela hash com sondagem linear, fator de carga <= 1/2).
+    Como o slot de um processo nunca muda, o indice so e alterado na insercao e
+    na remocao; os movimentos da heap atualizam apenas position[].
+*/
+typedef struct {
+    int id;
+    int slot;              //-1 indica entrada livre
+} IndexEntry;
+
+typedef struct {
+    Heap lanes[2];         //0: interativos, 1: background
+    int arity_log2;        //Aridade = 1 << arity_log2
+
+    Process *processes;    //Slots com os dados dos processos
+    int *position;         //Posicao de cada slot ocupado na heap do seu tipo
+    int *free_slots;
+    int n_free, slots_used, slot_capacity;
+
+    IndexEntry *index;
+    int index_capacity;    //Potencia de 2
+
+    int size;
+    int clock;             //Numero de ciclos de aging ja aplicados
+} PriorityQueue;
+
+
+int aging_period(char type) {
+    return type == 'i' ? AGING_INTERACTIVE : AGING_BACKGROUND;
+}
+
+int lane_of(char type) {
+    return type == 'i' ? 0 : 1;
+}
+
+//Os periodos aparecem como constantes para que a divisao vire multiplicacao
+int effective_priority(const PriorityQueue *queue, const Process *p) {
+    int waited = queue->clock - p->enqueued_at;
+    return p->priority + (p->type == 'i' ? waited / AGING_INTERACTIVE : waited / AGING_BACKGROUND);
+}
+
+int wait_cycles(const PriorityQueue *queue, const Process *p) {
+    return (queue->clock - p->enqueued_at) % aging_period(p->type);
+}
+
+//Chave de ordenacao dentro de uma heap; invariante no tempo
+long long aging_key(const Process *p) {
+    return (long long)p->priority * aging_period(p->type) - p->enqueued_at;
+}
+
+
+/*
+    Criacao e destruicao
+*/
+
+//arity deve ser uma potencia de 2 a partir de 2
+PriorityQueue create_priority_queue_arity(int arity) {
+    PriorityQueue queue;
+    if (arity < 2 || (arity & (arity - 1)) != 0) {
+        fprintf(stderr, "Aridade invalida: %d (deve ser potencia de 2).\n", arity);
+        exit(1);
+    }
+    queue.arity_log2 = 0;
+    while ((1 << queue.arity_log2) < arity) queue.arity_log2++;
+    for (int l = 0; l < 2; l++) {
+        queue.lanes[l].size = 0;
+        queue.lanes[l].capacity = 16;
+        queue.lanes[l].keys = (long long*)malloc(16 * sizeof(long long));
+        queue.lanes[l].slots = (int*)malloc(16 * sizeof(int));
+    }
+
+    queue.slot_capacity = 16;
+    queue.processes = (Process*)malloc(16 * sizeof(Process));
+    queue.position = (int*)malloc(16 * sizeof(int));
+    queue.free_slots = (int*)malloc(16 * sizeof(int));
+    queue.n_free = 0;
+    queue.slots_used = 0;
+
+    queue.index_capacity = 32;
+    queue.index = (IndexEntry*)malloc(32 * sizeof(IndexEntry));
+    for (int i = 0; i < 32; i++) queue.index[i].slot = -1;
+
+    queue.size = 0;
+    queue.clock = 0;
+    return queue;
+}
+
+PriorityQueue create_priority_queue() {
+    return create_priority_queue_arity(HEAP_ARITY);
+}
+
+void destroy_priority_queue(PriorityQueue *queue) {
+    for (int l = 0; l < 2; l++) {
+        free(queue->lanes[l].keys);
+        free(queue->lanes[l].slots);
+    }
+    free(queue->processes);
+    free(queue->position);
+    free(queue->free_slots);
+    free(queue->index);
+    queue->size = 0;
+}
+
+
+/*
+    Indice por id
+*/
+
+unsigned int index_hash(int id, int capacity) {
+    return ((unsigned int)id * 2654435761u) & (unsigned int)(capacity - 1);
+}
+
+//Entrada do id, ou a entrada livre onde ele seria inserido
+IndexEntry *index_entry(PriorityQueue *queue, int id) {
+    unsigned int mask = (unsigned int)(queue->index_capacity - 1);
+    unsigned int i = index_hash(id, queue->index_capacity);
+    while (queue->index[i].slot != -1 && queue->index[i].id != id) {
+        i = (i + 1) & mask;
+    }
+    return &queue->index[i];
+}
+
+void index_grow(PriorityQueue *queue) {
+    IndexEntry *old = queue->index;
+    int old_capacity = queue->index_capacity;
+
+    queue->index_capacity *= 2;
+    queue->index = (IndexEntry*)malloc(queue->index_capacity * sizeof(IndexEntry));
+    for (int i = 0; i < queue->index_capacity; i++) queue->index[i].slot = -1;
+    for (int i = 0; i < old_capacity; i++) {
+        if (old[i].slot != -1) *index_entry(queue, old[i].id) = old[i];
+    }
+    free(old);
+}
+
+void index_remove(PriorityQueue *queue, int id) {
+    unsigned int mask = (unsigned int)(queue->index_capacity - 1);
+    unsigned int i = (unsigned int)(index_entry(queue, id) - queue->index);
+    queue->index[i].slot = -1;
+
+    //Remocao por deslocamento: puxa para tras as entradas que sondaram depois de i
+    unsigned int j = i;
+    for (;;) {
+        j = (j + 1) & mask;
+        if (queue->index[j].slot == -1) return;
+        unsigned int home = index_hash(queue->index[j].id, queue->index_capacity);
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            queue->index[i] = queue->index[j];
+            queue->index[j].slot = -1;
+            i = j;
+        }
+    }
+}
+
+
+/*
+    Operacoes da heap indexada
+*/
+
+//Coloca o slot na posicao i da heap e atualiza sua posicao
+static inline void place(PriorityQueue *queue, Heap *heap, int i, long long key, int slot) {
+    heap->keys[i] = key;
+    heap->slots[i] = slot;
+    queue->position[slot] = i;
+}
+
+void sift_up(PriorityQueue *queue, int lane, int i) {
+    Heap *heap = &queue->lanes[lane];
+    long long key = heap->keys[i];
+    int slot = heap->slots[i];
+
+    while (i != 0) {
+        int parent = (i - 1) >> queue->arity_log2;
+
+        //Em caso de empate, o processo mais antigo continua na frente
+        if (heap->keys[parent] >= key) break;
+
+        place(queue, heap, i, heap->keys[parent], heap->slots[parent]);
+        i = parent;
+    }
+    place(queue, heap, i, key, slot);
+}
+
+void sift_down(PriorityQueue *queue, int lane, int i) {
+    Heap *heap = &queue->lanes[lane];
+    long long key = heap->keys[i];
+    int slot = heap->slots[i];
+
+    for (;;) {
+        int first = (i << queue->arity_log2) + 1;
+        if (first >= heap->size) break;
+
+        int last = first + (1 << queue->arity_log2);
+        if (last > heap->size) last = heap->size;
+
+        int child = first;
+        for (int c = first + 1; c < last; c++) {
+            if (heap->keys[c] > heap->keys[child]) child = c;
+        }
+        if (heap->keys[child] <= key) break;
+
+        place(queue, heap, i, heap->keys[child], heap->slots[child]);
+        i = child;
+    }
+    place(queue, heap, i, key, slot);
+}
+
+int allocate_slot(PriorityQueue *queue) {
+    if (queue->n_free > 0) return queue->free_slots[--queue->n_free];
+
+    if (queue->slots_used == queue->slot_capacity) {
+        queue->slot_capacity *= 2;
+        queue->processes = (Process*)realloc(queue->processes, queue->slot_capacity * sizeof(Process));
+        queue->position = (int*)realloc(queue->position, queue->slot_capacity * sizeof(int));
+        queue->free_slots = (int*)realloc(queue->free_slots, queue->slot_capacity * sizeof(int));
+    }
+    return queue->slots_used++;
+}
+
+//Insere uma copia do processo, mantendo seu credito de espera e ciclos executados.
+//Retorna 0 se ja houver um processo com o mesmo id
+int insert_process(PriorityQueue *queue, const Process *process) {
+    IndexEntry *entry = index_entry(queue, process->id);
+    if (entry->slot != -1) return 0;
+    if (2 * (queue->size + 1) > queue->index_capacity) {
+        index_grow(queue);
+        entry = index_entry(queue, process->id);
+    }
+
+    int slot = allocate_slot(queue);
+    Process *p = &queue->processes[slot];
+    *p = *process;
+
+    entry->id = p->id;
+    entry->slot = slot;
+
+    int lane = lane_of(p->type);
+    Heap *heap = &queue->lanes[lane];
+    if (heap->size == heap->capacity) {
+        heap->capacity *= 2;
+        heap->keys = (long long*)realloc(heap->keys, heap->capacity * sizeof(long long));
+        heap->slots = (int*)realloc(heap->slots, heap->capacity * sizeof(int));
+    }
+    place(queue, heap, heap->size++, aging_key(p), slot);
+    sift_up(queue, lane, heap->size - 1);
+    queue->size++;
+    return 1;
+}
+
+//Retorna 0 se ja houver um processo com o mesmo id
+int insert(PriorityQueue *queue, int id, int priority, char type, int required_cycles) {
+    Process p = {id, priority, queue->clock, 0, required_cycles, queue->clock, type};
+    return insert_process(queue, &p);
+}
+
+Process *find_process(PriorityQueue *queue, int id) {
+    int slot = index_entry(queue, id)->slot;
+    return slot == -1 ? NULL : &queue->processes[slot];
+}
+
+//Processo no topo de uma heap
+static inline Process *lane_top(const PriorityQueue *queue, int lane) {
+    return &queue->processes[queue->lanes[lane].slots[0]];
+}
+
+//Heap cujo topo tem a maior prioridade efetiva; interativos vencem empates
+int max_lane(PriorityQueue *queue) {
+    if (queue->lanes[1].size == 0) return 0;
+    if (queue->lanes[0].size == 0) return 1;
+
+    if (effective_priority(queue, lane_top(queue, 1)) > effective_priority(queue, lane_top(queue, 0))) {
+        return 1;
+    }
+    return 0;
+}
+
+//Processo que sera executado a seguir, sem remove-lo; NULL se a fila estiver vazia
+Process *peek(PriorityQueue *queue) {
+    if (queue->size == 0) return NULL;
+    return lane_top(queue, max_lane(queue));
+}
+
+//Define a prioridade efetiva do processo no slot, preservando seu credito de espera
+void change_priority_slot(PriorityQueue *queue, int slot, int new_priority) {
+    Process *p = &queue->processes[slot];
+    int lane = lane_of(p->type), pos = queue->position[slot];
+    int old_priority = effective_priority(queue, p);
+    p->priority += new_priority - old_priority;
+    queue->lanes[lane].keys[pos] = aging_key(p);
+
+    if (new_priority > old_priority) sift_up(queue, lane, pos);
+    else sift_down(queue, lane, pos);
+}
+
+//Define a prioridade efetiva de um processo, preservando seu credito de espera
+int change_priority(PriorityQueue *queue, int id, int new_priority) {
+    int slot = index_entry(queue, id)->slot;
+    if (slot == -1) return 0;
+    change_priority_slot(queue, slot, new_priority);
+    return 1;
+}
+
+Process remove_at(PriorityQueue *queue, int lane, int pos) {
+    Heap *heap = &queue->lanes[lane];
+    int slot = heap->slots[pos];
+    Process removed = queue->processes[slot];
+    index_remove(queue, removed.id);
+    queue->free_slots[queue->n_free++] = slot;
+
+    heap->size--;
+    if (pos < heap->size) {
+        long long key = heap->keys[heap->size];
+        place(queue, heap, pos, key, heap->slots[heap->size]);
+        if (pos > 0 && key > heap->keys[(pos - 1) >> queue->arity_log2]) sift_up(queue, lane, pos);
+        else sift_down(queue, lane, pos);
+    }
+    queue->size--;
+    return removed;
+}
+
+//Cancela um processo qualquer pelo id; retorna 0 se ele nao estiver na fila
+int remove_by_id(PriorityQueue *queue, int id, Process *removed) {
+    int slot = index_entry(queue, id)->slot;
+    if (slot == -1) return 0;
+    Process p = remove_at(queue, lane_of(queue->processes[slot].type), queue->position[slot]);
+    if (removed != NULL) *removed = p;
+    return 1;
+}
+
+Process remove_max(PriorityQueue *queue) {
+    return remove_at(queue, max_lane(queue), 0);
+}
+
+/*
+    Executa um ciclo do processo no topo, com as mesmas regras de execute_process()
+    em main.c mas sem imprimir nada: perto do fim, interativos sobem para
+    prioridade 10 e background para 9. Retorna 0 se a fila estiver vazia, 1 se
+    o processo continua na fila e 2 se ele terminou (copiado em *finished)
+*/
+int execute_cycle(PriorityQueue *queue, Process *finished) {
+    if (queue->size == 0) return 0;
+
+    //Trabalha direto pelo slot para nao consultar o indice por id
+    int lane = max_lane(queue);
+    int slot = queue->lanes[lane].slots[0];
+    Process *p = &queue->processes[slot];
+
+    p->executed_cycles++;
+
+    if (p->required_cycles - p->executed_cycles <= 1) {
+        int priority = effective_priority(queue, p);
+        if (p->type == 'i' && priority < 10) change_priority_slot(queue, slot, 10);
+        else if (p->type == 'b' && priority < 9) change_priority_slot(queue, slot, 9);
+    }
+
+    if (p->executed_cycles >= p->required_cycles) {
+        *finished = remove_at(queue, lane, queue->position[slot]);
+        return 2;
+    }
+    return 1;
+}
+
+//Avanca o relogio: todos os processos na fila ganham um ciclo de espera em O(1).
+//Como a ordem dentro de cada heap nao muda, nenhuma posicao do indice precisa ser atualizada
+void aging(PriorityQueue *queue) {
+    queue->clock++;
+}
+
+#endif
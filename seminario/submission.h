@@ -0,0 +1,165 @@
+#ifndef SUBMISSION_H
+#define SUBMISSION_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include "priority_queue.h"
+
+/*
+    Buffer de submissao
+
+    insert() altera a heap sem sincronizacao, entao so a thread do
+    escalonador pode chama-la. Outras threads submetem processos por este
+    buffer, e o escalonador os passa para a heap em lote com
+    drain_submissions() entre duas chamadas de execute_process().
+
+    O buffer e uma fila MPSC sem locks (a fila intrusiva de Vyukov): cada
+    produtor publica um no com uma unica troca atomica no fim da lista, e o
+    consumidor percorre a lista a partir do inicio sem nenhuma operacao
+    atomica de leitura-modificacao-escrita. Para dividir o custo da troca e
+    da alocacao, cada produtor acumula ate SUBMISSION_BATCH processos em um
+    no local e so publica o no cheio (ou em flush_submissions()).
+*/
+
+#define SUBMISSION_BATCH 64
+
+typedef struct {
+    int id;
+    int priority;
+    int required_cycles;
+    char type;
+} Submission;
+
+typedef struct SubmissionNode {
+    _Atomic(struct SubmissionNode*) next;
+    int count;
+    Submission items[];              //batch_size do produtor (ate SUBMISSION_BATCH)
+} SubmissionNode;
+
+typedef struct {
+    _Atomic(SubmissionNode*) last;   //Usado pelos produtores
+    _Alignas(64) SubmissionNode *first;  //Usado so pelo consumidor, em outra linha de cache
+    SubmissionNode *stub;            //No vazio que mantem a lista sempre nao vazia
+    long rejected;                   //Ids repetidos descartados na drenagem
+} SubmissionBuffer;
+
+//Estado local de um produtor; cada thread produtora usa o seu
+typedef struct {
+    SubmissionBuffer *buffer;
+    SubmissionNode *pending;         //No sendo preenchido, ainda nao publicado
+    int batch_size;                  //Processos por no (1 .. SUBMISSION_BATCH)
+} Producer;
+
+
+void init_submission_buffer(SubmissionBuffer *buffer) {
+    //Um no com membro flexivel nao pode ficar embutido na struct: o stub e alocado sem itens
+    buffer->stub = (SubmissionNode*)malloc(sizeof(SubmissionNode));
+    atomic_init(&buffer->stub->next, NULL);
+    buffer->stub->count = 0;
+    atomic_init(&buffer->last, buffer->stub);
+    buffer->first = buffer->stub;
+    buffer->rejected = 0;
+}
+
+static void publish(SubmissionBuffer *buffer, SubmissionNode *node) {
+    atomic_store_explicit(&node->next, NULL, memory_order_relaxed);
+    SubmissionNode *previous = atomic_exchange_explicit(&buffer->last, node, memory_order_acq_rel);
+    //Entre a troca e este store a lista fica momentaneamente partida; o consumidor espera
+    atomic_store_explicit(&previous->next, node, memory_order_release);
+}
+
+//Proximo no publicado, ou NULL se nao houver nenhum completo
+static SubmissionNode *take_node(SubmissionBuffer *buffer) {
+    SubmissionNode *first = buffer->first;
+    SubmissionNode *next = atomic_load_explicit(&first->next, memory_order_acquire);
+
+    if (first == buffer->stub) {
+        if (next == NULL) return NULL;
+        buffer->first = first = next;
+        next = atomic_load_explicit(&next->next, memory_order_acquire);
+    }
+    if (next != NULL) {
+        buffer->first = next;
+        return first;
+    }
+
+    //first e o ultimo no visivel: so pode sair se nenhum produtor estiver no meio de um publish
+    if (first != atomic_load_explicit(&buffer->last, memory_order_acquire)) return NULL;
+    publish(buffer, buffer->stub);
+    next = atomic_load_explicit(&first->next, memory_order_acquire);
+    if (next != NULL) {
+        buffer->first = next;
+        return first;
+    }
+    return NULL;
+}
+
+
+/*
+    Produtores
+*/
+
+Producer create_producer(SubmissionBuffer *buffer, int batch_size) {
+    Producer producer;
+    producer.buffer = buffer;
+    producer.pending = NULL;
+    producer.batch_size = batch_size < 1 ? 1 : batch_size > SUBMISSION_BATCH ? SUBMISSION_BATCH : batch_size;
+    return producer;
+}
+
+//Publica o lote parcial do produtor, se houver
+void flush_submissions(Producer *producer) {
+    if (producer->pending == NULL) return;
+    publish(producer->buffer, producer->pending);
+    producer->pending = NULL;
+}
+
+void submit(Producer *producer, int id, int priority, char type, int required_cycles) {
+    if (producer->pending == NULL) {
+        //O no so tem espaco para o lote do produtor
+        producer->pending = (SubmissionNode*)malloc(sizeof(SubmissionNode)
+                                                    + producer->batch_size * sizeof(Submission));
+        producer->pending->count = 0;
+    }
+    SubmissionNode *node = producer->pending;
+    Submission *s = &node->items[node->count++];
+    s->id = id;
+    s->priority = priority;
+    s->type = type;
+    s->required_cycles = required_cycles;
+
+    if (node->count == producer->batch_size) flush_submissions(producer);
+}
+
+
+/*
+    Consumidor (a thread do escalonador)
+*/
+
+//Move para a heap tudo o que ja foi publicado; retorna quantos processos entraram na fila
+int drain_submissions(SubmissionBuffer *buffer, PriorityQueue *queue) {
+    int inserted = 0;
+    SubmissionNode *node;
+    while ((node = take_node(buffer)) != NULL) {
+        for (int i = 0; i < node->count; i++) {
+            Submission *s = &node->items[i];
+            if (insert(queue, s->id, s->priority, s->type, s->required_cycles)) inserted++;
+            else buffer->rejected++;
+        }
+        if (node != buffer->stub) free(node);
+    }
+    return inserted;
+}
+
+//Descarta o que sobrou no buffer; so deve ser chamada sem produtores ativos
+void destroy_submission_buffer(SubmissionBuffer *buffer) {
+    SubmissionNode *node;
+    while ((node = take_node(buffer)) != NULL) {
+        if (node != buffer->stub) free(node);
+    }
+    free(buffer->stub);
+    buffer->stub = NULL;
+}
+
+#endif